@@ -655,6 +655,8 @@ namespace thermalfist {
      *        contributions.
      * 
      * Calculation is based on the primordial densities computed by CalculateDensities().
+     * In the eBW scheme the thermal branching ratios are only recomputed
+     * if the temperature or chemical potentials have changed.
      * 
      */
     virtual void CalculateFeeddown();
@@ -1203,6 +1205,10 @@ namespace thermalfist {
     std::vector< std::vector<double> > m_densitiesbyfeeddown;
     std::vector<double> m_Chem;
 
+    // T, fugacities, and chemical potentials at which the thermal branching ratios were last computed (eBW scheme)
+    std::vector<double> m_ThermalBranchingRatiosParameters;
+    int m_ThermalBranchingRatiosRevision;
+
     // Scaled variance
     std::vector<double> m_wprim;
     std::vector<double> m_wtot;
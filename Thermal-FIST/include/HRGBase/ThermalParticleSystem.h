@@ -190,6 +190,50 @@ namespace thermalfist {
      */
     const std::vector<DecayContributionsToAllParticles>& DecayContributionsByFeeddown() const { return m_DecayContributionsByFeeddown; }
 
+    /**
+     * \brief Feeddown matrix in the compressed sparse row (CSR) format.
+     * 
+     * Row i contains the mean numbers of species i resulting from the decays
+     * of the resonances listed in Columns, plus the unit diagonal element
+     * accounting for the primordial yield of species i.
+     */
+    struct FeeddownMatrix {
+      std::vector<int> RowOffsets;  ///< Row i occupies the range [RowOffsets[i], RowOffsets[i+1])
+      std::vector<int> Columns;     ///< 0-based indices of the resonances
+      std::vector<double> Values;   ///< Mean numbers of particles from the resonance decays
+    };
+
+    /// The feeddown matrix for the given Feeddown::Type. Same content as DecayContributionsByFeeddown().
+    const FeeddownMatrix& FeeddownMatrixByType(Feeddown::Type feeddown) const { return m_FeeddownMatrices[feeddown]; }
+
+    /**
+     * \brief Applies the feeddown to a vector of primordial densities (or yields).
+     * 
+     * \param densities Primordial densities, one per particle species
+     * \param feeddown  The feeddown type
+     * \return std::vector<double> Densities including the feeddown contributions
+     */
+    std::vector<double> ApplyFeeddown(const std::vector<double>& densities, Feeddown::Type feeddown = Feeddown::StabilityFlag) const;
+
+    /**
+     * \brief Applies the feeddown to many sets of primordial densities at once,
+     *        e.g. for different points of a scan or different hypersurface cells.
+     * 
+     * Performed as a single product of the sparse feeddown matrix 
+     * and the dense matrix of the primordial densities.
+     * Note that with the energy-dependent Breit-Wigner scheme (eBW) the branching ratios,
+     * and thus the feeddown matrix, correspond to the temperature and chemical potentials 
+     * at which ProcessDecays() was last called.
+     * 
+     * \param densities Primordial densities, one vector with an element per particle species for each state
+     * \param feeddown  The feeddown type
+     * \return std::vector< std::vector<double> > Densities including the feeddown contributions, one vector for each state
+     */
+    std::vector< std::vector<double> > ApplyFeeddown(const std::vector< std::vector<double> >& densities, Feeddown::Type feeddown = Feeddown::StabilityFlag) const;
+
+    /// Incremented each time the decay contributions are recomputed by ProcessDecays()
+    int DecaysRevision() const { return m_DecaysRevision; }
+
     /**
      * \brief Cumulants of particle number distributions of from decays.
      * 
@@ -208,6 +252,28 @@ namespace thermalfist {
      */
     const std::vector<ResonanceFinalStatesDistribution>& ResonanceFinalStatesDistributions() const { return m_ResonanceFinalStatesDistributions; }
 
+    /// 0-based indices of all stable particle species in the list
+    const std::vector<int>& StableParticleIndices() const { return m_StableParticleIndices; }
+
+    /// 0-based indices of the resonances which contribute to DecayCovariances()
+    const std::vector<int>& DecayCovarianceResonances() const { return m_DecayCovarianceResonances; }
+
+    /**
+     * \brief Covariances of the final state numbers of stable particles
+     *        from the probabilistic decays of each resonance.
+     * 
+     * Computed from ResonanceFinalStatesDistributions().
+     * Stored as a contiguous column-major matrix with
+     * Ns*Ns rows and Nr columns, where Ns is the size of StableParticleIndices()
+     * and Nr the size of DecayCovarianceResonances().
+     * Element (a*Ns + b, k) is the covariance of the numbers of stable particles
+     * StableParticleIndices()[a] and StableParticleIndices()[b] produced in the
+     * decay of resonance DecayCovarianceResonances()[k].
+     * 
+     * \return const std::vector<double>& -- The flattened matrix
+     */
+    const std::vector<double>& DecayCovariances() const { return m_DecayCovariances; }
+
     /**
      * \brief Loads the particle list from file.
      *
@@ -576,6 +642,12 @@ namespace thermalfist {
     /// Load particle list from the iSS sampler format used at https://github.com/chunshen1987/iSS
     void LoadListiSS(const std::string& filename, const std::set<std::string>& flags = std::set<std::string>(), double mcut = 1.e9);
 
+    /// Computes the covariances of stable particle numbers from the resonance final state distributions
+    void FillDecayCovariances();
+
+    /// Fills the CSR feeddown matrix from the decay contributions
+    void FillFeeddownMatrix(Feeddown::Type feeddown);
+
   private:
     std::vector<ThermalParticle>    m_Particles;
     std::map<long long, int>              m_PDGtoID;
@@ -603,6 +675,13 @@ namespace thermalfist {
     // Map for DP-based calculations of decay distributions
     std::vector<ResonanceFinalStatesDistribution> m_DecayDistributionsMap;
 
+    std::vector<FeeddownMatrix> m_FeeddownMatrices;
+    int m_DecaysRevision;
+
+    std::vector<int> m_StableParticleIndices;
+    std::vector<int> m_DecayCovarianceResonances;
+    std::vector<double> m_DecayCovariances;
+
     SortModeType m_SortMode;
   };
 
@@ -17,4 +17,9 @@
 #include "HRGEventGenerator/CracowFreezeoutEventGenerator.h"
 #include "HRGEventGenerator/EventWriter.h"
 #include "HRGEventGenerator/HepMCEventWriter.h"
+#include "HRGEventGenerator/BinaryEventWriter.h"
+#include "HRGEventGenerator/RootEventWriter.h"
+#include "HRGEventGenerator/EventCumulants.h"
+#include "HRGEventGenerator/PairCorrelations.h"
+#include "HRGEventGenerator/MultiplicityClassEventGenerator.h"
 #include "HRGEventGenerator/HypersurfaceSampler.h"
\ No newline at end of file
@@ -10,8 +10,10 @@
 
 #include <vector>
 #include <string>
+#include <map>
 
 #include "HRGBase/BilinearSplineFunction.h"
+#include "HRGEventGenerator/SimpleParticle.h"
 
 namespace thermalfist {
 
@@ -50,6 +52,56 @@ namespace thermalfist {
      *  Read the acceptance function from file.
      */
     int ReadAcceptanceFunction(AcceptanceFunction & func, std::string filename);
+
+    /// \brief Window in rapidity, transverse momentum, and pseudorapidity.
+    ///        No restrictions by default.
+    struct KinematicWindow {
+      double ymin, ymax;     ///< Rapidity range
+      double ptmin, ptmax;   ///< Transverse momentum range (GeV)
+      double etamin, etamax; ///< Pseudorapidity range
+
+      KinematicWindow(double ymin_ = -1.e100, double ymax_ = 1.e100,
+        double ptmin_ = 0., double ptmax_ = 1.e100,
+        double etamin_ = -1.e100, double etamax_ = 1.e100) :
+        ymin(ymin_), ymax(ymax_), ptmin(ptmin_), ptmax(ptmax_), etamin(etamin_), etamax(etamax_) { }
+
+      /// Whether the particle is within the window
+      bool Contains(const SimpleParticle & part) const;
+    };
+
+    /**
+     *  \brief Per-species acceptance of the final-state particles in the event generator.
+     *
+     *  Only the listed species are accepted, each within its kinematic window and,
+     *  optionally, with the binomial acceptance probability given by an acceptance function.
+     *  See EventGeneratorBase::SetAcceptanceFilter().
+     */
+    class AcceptanceFilter {
+    public:
+      AcceptanceFilter() { }
+
+      /**
+       *  \brief Accepts the species with the given pdg code.
+       *
+       *  \param pdgid    The pdg code (particles and antiparticles are added separately)
+       *  \param window   The kinematic window
+       *  \param function The acceptance function in y and pT, not owned, NULL for none
+       */
+      void AddSpecies(long long pdgid, const KinematicWindow & window = KinematicWindow(), const AcceptanceFunction * function = NULL);
+
+      /// Whether the species with the given pdg code can be accepted at all
+      bool ContainsSpecies(long long pdgid) const { return m_Species.count(pdgid) > 0; }
+
+      /// Whether the particle is accepted. Draws a random number if an acceptance function is used.
+      bool Accept(const SimpleParticle & part) const;
+
+    private:
+      struct SpeciesAcceptance {
+        KinematicWindow window;
+        const AcceptanceFunction * function;
+      };
+      std::map<long long, SpeciesAcceptance> m_Species;
+    };
   }
 
 } // namespace thermalfist
@@ -0,0 +1,164 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#ifndef BINARYEVENTWRITER_H
+#define BINARYEVENTWRITER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "EventWriter.h"
+
+
+namespace thermalfist {
+
+  /**
+   * \brief Layout of the binary columnar event files written by BinaryEventWriter.
+   *
+   * The file starts with a header: the magic string "TFISTBEV" (8 bytes),
+   * the byte order mark 0x01020304, the format version, and the content flags (uint32 each).
+   *
+   * The events follow in blocks. Each block has a header
+   * (number of events and particles as uint32, raw and stored payload sizes as uint64)
+   * and a payload, which is zlib-compressed if the Compressed flag is set.
+   * The payload contains the per-event particle offsets (uint32, nevents + 1),
+   * event weights and log-weights (double), followed by the particle columns
+   * pdg (int64), px, py, pz, m, [r0, rx, ry, rz] (float or double), [mother pdg (int64)], [decay epoch (int32)].
+   *
+   */
+  namespace BinaryEventFormat {
+    /// Format version
+    const unsigned int Version = 1;
+
+    /// Content flags stored in the file header
+    enum Flags {
+      SinglePrecision = 1,  ///< Real-valued columns are stored as float32
+      Coordinates = 2,      ///< Space-time coordinates are stored
+      MotherPDG = 4,        ///< PDG code of the mother particle is stored
+      DecayEpoch = 8,       ///< Decay epoch is stored
+      PhotonsLeptons = 16,  ///< Decay photons and leptons are appended to the particle list of each event
+      Compressed = 32       ///< Block payloads are zlib-compressed
+    };
+
+    /// Whether the library was compiled with zlib support
+    bool CompressionAvailable();
+  }
+
+  /// \brief Writes the events in a compact binary columnar format, see BinaryEventFormat
+  ///
+  /// The events are accumulated in blocks of a fixed number of events,
+  /// each block is written column by column. The energy is not stored and
+  /// is recomputed from the momentum and mass when reading the events back.
+  /// Use BinaryEventReader to read the file or convert it to the other formats.
+  class BinaryEventWriter
+    : public EventWriter
+  {
+  public:
+    /**
+     * \brief Construct a new BinaryEventWriter object
+     *
+     * \param filename        Output file name
+     * \param config          Which optional columns to write (coordinates, mother pdg, decay epoch, photons/leptons)
+     * \param singlePrecision Store the real-valued columns as float32
+     * \param compressionLevel zlib compression level of the blocks (0 - no compression, 1-9)
+     * \param eventsPerBlock  Number of events per block
+     */
+    BinaryEventWriter(const std::string& filename = "",
+      const SimpleEvent::EventOutputConfig& config = SimpleEvent::EventOutputConfig(),
+      bool singlePrecision = false,
+      int compressionLevel = 0,
+      int eventsPerBlock = 1000);
+
+    virtual ~BinaryEventWriter();
+
+    virtual bool OpenFile(const std::string& filename);
+
+    virtual void CloseFile();
+
+    virtual bool WriteEvent(const SimpleEvent& evt);
+
+    /// Writes the accumulated events to the file
+    void Flush();
+
+  private:
+    void AddParticle(const SimpleParticle& part);
+
+    unsigned int m_Flags;
+    int m_CompressionLevel;
+    int m_EventsPerBlock;
+
+    std::vector<unsigned int> m_Offsets;
+    std::vector<double> m_Weights, m_LogWeights;
+    std::vector<long long> m_PDG, m_MotherPDG;
+    std::vector<double> m_Px, m_Py, m_Pz, m_M;
+    std::vector<double> m_R0, m_Rx, m_Ry, m_Rz;
+    std::vector<int> m_Epoch;
+
+    std::vector<char> m_Payload, m_Compressed;
+  };
+
+  /// \brief Reads the events written by BinaryEventWriter
+  class BinaryEventReader
+  {
+  public:
+    BinaryEventReader(const std::string& filename = "");
+    ~BinaryEventReader();
+
+    bool OpenFile(const std::string& filename);
+
+    void CloseFile();
+
+    /// Whether the file is open and its header is valid
+    bool IsOpen() const { return m_fin.is_open(); }
+
+    /// Content flags of the file, see BinaryEventFormat::Flags
+    unsigned int Flags() const { return m_Flags; }
+
+    /// Output configuration corresponding to the stored columns
+    SimpleEvent::EventOutputConfig OutputConfig() const;
+
+    /// Reads the next event. Returns false if there are no more events.
+    bool ReadEvent(SimpleEvent& evt);
+
+    /// Number of events read so far
+    long long EventsRead() const { return m_EventsRead; }
+
+    /**
+     * \brief Writes all the remaining events in the file with
+     *        the provided writer, e.g. EventWriterAsciiExtended or HepMCEventWriter
+     *
+     * \param writer    Event writer with an open output file
+     * \param maxevents Maximum number of events to convert, all remaining events if negative
+     * \return          The number of converted events
+     */
+    long long ConvertEvents(EventWriter& writer, long long maxevents = -1);
+
+  private:
+    bool ReadBlock();
+
+    std::ifstream m_fin;
+    unsigned int m_Flags;
+    long long m_EventsRead;
+    unsigned long long m_FileSize;
+
+    unsigned int m_BlockEvents;
+    unsigned int m_BlockEventIndex;
+
+    std::vector<unsigned int> m_Offsets;
+    std::vector<double> m_Weights, m_LogWeights;
+    std::vector<long long> m_PDG, m_MotherPDG;
+    std::vector<double> m_Px, m_Py, m_Pz, m_M;
+    std::vector<double> m_R0, m_Rx, m_Ry, m_Rz;
+    std::vector<int> m_Epoch;
+
+    std::vector<char> m_Payload, m_Compressed;
+  };
+
+} // namespace thermalfist
+
+#endif
@@ -38,7 +38,7 @@ namespace thermalfist {
       double RoverTauH = 1.5,
       double etamax = 0.5);
 
-    ~CracowFreezeoutEventGenerator() { }
+    ~CracowFreezeoutEventGenerator();
 
     /// Sets the momentum distribution parameters
     void SetParameters(double T, double RoverTauH, double etamax);
@@ -53,6 +53,9 @@ namespace thermalfist {
     double GetEtaMax() const { return m_EtaMax; }
   private:
     double m_T, m_RoverTauH, m_EtaMax;
+
+    /// Tabulated freeze-out parametrization shared by the momentum generators of all species
+    BoostInvariantFreezeoutTable* m_FreezeoutTable;
   };
 
 } // namespace thermalfist
@@ -52,7 +52,7 @@ namespace thermalfist {
       EventGeneratorConfiguration::ModelType EV = EventGeneratorConfiguration::PointParticle, 
       ThermalModelBase *THMEVVDW = NULL);
     
-    ~CylindricalBlastWaveEventGenerator() { }
+    ~CylindricalBlastWaveEventGenerator();
 
     /// Sets the momentum distribution parameters
     void SetParameters(double T, double betas, double etamax, double npow = 1.);
@@ -83,6 +83,9 @@ namespace thermalfist {
     double GetVeffIntegral() const;
 
     double m_T, m_BetaS, m_EtaMax, m_n, m_Rperp;
+
+    /// Tabulated freeze-out parametrization shared by the momentum generators of all species
+    BoostInvariantFreezeoutTable* m_FreezeoutTable;
   };
 
   /// For backward compatibility
@@ -0,0 +1,119 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#ifndef EVOVERLAPINDEX_H
+#define EVOVERLAPINDEX_H
+
+#include <vector>
+
+#include "HRGEventGenerator/SimpleParticle.h"
+
+namespace thermalfist {
+
+  /// \brief Compact table of the pairwise excluded-volume radii.
+  ///
+  /// Species with identical sets of radii share a class,
+  /// the radii are stored as a flat matrix over the classes.
+  class EVRadiiTable
+  {
+  public:
+    EVRadiiTable() : m_NumberOfClasses(0), m_MaxRadius(0.) { }
+
+    /// Constructs the table from the full matrix of radii (in fm) over all species
+    EVRadiiTable(const std::vector< std::vector<double> >& radii);
+
+    /// Radius (in fm) for the pair of species with ids id1 and id2
+    double Radius(int id1, int id2) const { return m_Radii[m_Classes[id1] * m_NumberOfClasses + m_Classes[id2]]; }
+
+    /// The largest radius of a pair involving species id
+    double MaxRadius(int id) const { return m_MaxRadii[m_Classes[id]]; }
+
+    /// The largest radius among all pairs
+    double MaxRadius() const { return m_MaxRadius; }
+
+    /// Number of distinct classes of species
+    int NumberOfClasses() const { return m_NumberOfClasses; }
+
+    /// Number of species
+    int NumberOfSpecies() const { return static_cast<int>(m_Classes.size()); }
+
+  private:
+    std::vector<int> m_Classes;
+    int m_NumberOfClasses;
+    std::vector<double> m_Radii;
+    std::vector<double> m_MaxRadii;
+    double m_MaxRadius;
+  };
+
+  /**
+   * \brief Cell list for the excluded-volume overlap checks in the coordinate space.
+   *
+   * Two particles overlap if their distance in the pair rest frame, evaluated at the emission time of the
+   * later particle (see ParticleDecaysMC::ParticleDistanceSquared()), does not exceed twice their EV radius.
+   * If so, the distance of their emission points in the generator frame satisfies
+   * \f$ |\Delta \mathbf{r}| \leq 4 r \max(\gamma_1, \gamma_2) + |\Delta t| \f$.
+   * The particles are stored in hashed grids over (t, x, y, z), one for each range of
+   * Lorentz factors, and only the cells permitted by this bound are examined.
+   * The result is thus identical to the brute force check of all pairs.
+   *
+   */
+  class EVOverlapIndex
+  {
+  public:
+    EVOverlapIndex(const EVRadiiTable* radii = NULL);
+
+    /// Sets the table of radii, clears the index
+    void SetRadiiTable(const EVRadiiTable* radii);
+
+    /// Removes all the particles, expectedSize is used to size the hash tables
+    void Clear(int expectedSize = 0);
+
+    /// Adds particle part of species id to the index. Species without excluded volume are not stored.
+    void Insert(const SimpleParticle& part, int id);
+
+    /// Whether particle cand of species id overlaps with any of the stored particles
+    bool CheckOverlap(const SimpleParticle& cand, int id) const;
+
+    /// Number of stored particles
+    int Size() const { return static_cast<int>(m_Particles.size()); }
+
+  private:
+    /// Hashed grid for particles with the Lorentz factor up to GammaThreshold
+    struct Grid {
+      double CellSize;
+      double GammaThreshold;
+      double GammaStored;
+      std::vector<int> Head;
+      std::vector<int> Members;
+      int HashMask;
+      int TimeCellMin, TimeCellMax;
+    };
+
+    int CellIndex(const Grid& grid, double x) const;
+    int Bucket(const Grid& grid, int it, int ix, int iy, int iz) const;
+    void Rehash(Grid& grid, int size);
+    void InsertInGrid(Grid& grid, int index);
+    bool CheckGrid(const Grid& grid, const SimpleParticle& cand, int id, double gamma, double rmax) const;
+    bool CheckPair(const SimpleParticle& cand, int id, int ipart) const;
+
+    const EVRadiiTable* m_RadiiTable;
+
+    std::vector<SimpleParticle> m_Particles;
+    std::vector<int> m_Ids;
+
+    /// Linked lists of the particles in the hash table buckets
+    std::vector<int> m_Next;
+
+    std::vector<Grid> m_Grids;
+
+    /// Particles with the Lorentz factor above all grid thresholds, these are checked by brute force
+    std::vector<int> m_Fast;
+  };
+
+} // namespace thermalfist
+
+#endif
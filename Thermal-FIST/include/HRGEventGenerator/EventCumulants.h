@@ -0,0 +1,219 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#ifndef EVENTCUMULANTS_H
+#define EVENTCUMULANTS_H
+
+#include <vector>
+#include <map>
+
+#include "HRGBase/ThermalParticleSystem.h"
+#include "HRGEventGenerator/SimpleEvent.h"
+#include "MersenneTwister.h"
+
+namespace thermalfist {
+
+  /**
+   * \brief An event-by-event observable which is a linear combination of the
+   *        final state particle numbers, \f$ X = \sum_i c_i N_i \f$.
+   *
+   * Examples are the conserved charges, particle numbers, and net-particle numbers.
+   */
+  class EventObservable
+  {
+  public:
+    /// Empty observable, the species are added with AddSpecies()
+    EventObservable() { }
+
+    /// Conserved charge chg carried by the particles of the list TPS
+    EventObservable(const ThermalParticleSystem* TPS, ConservedCharge::Name chg);
+
+    /// Adds species with PDG code pdgid and the coefficient c to the observable
+    void AddSpecies(long long pdgid, double c = 1.);
+
+    /// The value of the observable in the event ev
+    double Value(const SimpleEvent& ev) const;
+
+    /// Number of particles with PDG code pdgid
+    static EventObservable ParticleNumber(long long pdgid);
+
+    /// Number of particles with PDG code pdgid minus the number of antiparticles
+    static EventObservable NetParticleNumber(long long pdgid);
+
+  private:
+    std::map<long long, double> m_Coefficients;
+  };
+
+  /**
+   * \brief Single-pass accumulator of the weighted central moments and joint cumulants
+   *        of several event-by-event observables.
+   *
+   * Stores the sums \f$ M_\alpha = \sum_{ev} w_{ev} \prod_k (X_k - \langle X_k \rangle)^{\alpha_k} \f$
+   * for all multi-indices \f$ |\alpha| \leq \f$ MaxOrder() about the running means.
+   * These are updated with each event and merged between accumulators using
+   * the numerically stable formulas of Pébay (the events are not stored).
+   * The joint cumulants are obtained from the central moments
+   * via the sum over the partitions of the set of indices.
+   *
+   * Statistical errors can be estimated by subsampling, where the events are distributed
+   * between NumberOfSamples() independent sub-accumulators,
+   * or by the Poisson bootstrap, where each event enters each of the
+   * NumberOfSamples() replicas with a weight sampled from the Poisson distribution with unit mean.
+   *
+   * Accumulators with the same configuration filled in different threads
+   * can be combined with Merge().
+   *
+   */
+  class EventCumulantAccumulator
+  {
+  public:
+    /// Method for estimating statistical errors
+    enum ErrorEstimate {
+      NoErrors = 0,    ///< No error estimate
+      Subsampling = 1, ///< Events distributed round-robin between independent subsamples
+      Bootstrap = 2    ///< Poisson bootstrap replicas
+    };
+
+    /**
+     * \brief Construct a new EventCumulantAccumulator object
+     *
+     * \param numberOfObservables Number of observables
+     * \param maxOrder            Highest order of the moments
+     * \param errors              Method for estimating the statistical errors
+     * \param numberOfSamples     Number of subsamples or bootstrap replicas (10 and 100 by default, respectively)
+     */
+    EventCumulantAccumulator(int numberOfObservables = 1, int maxOrder = 4, ErrorEstimate errors = NoErrors, int numberOfSamples = 0);
+
+    /**
+     * \brief Construct a new EventCumulantAccumulator object for the given set of observables
+     *
+     * The observables are evaluated in each event passed to AddEvent()
+     */
+    EventCumulantAccumulator(const std::vector<EventObservable>& observables, int maxOrder = 4, ErrorEstimate errors = NoErrors, int numberOfSamples = 0);
+
+    /// Removes all accumulated events
+    void Clear();
+
+    /// Seed of the generator of bootstrap weights (by default drawn from RandomGenerators::randgenMT), accumulators in different threads should use different seeds
+    void SetSeed(unsigned int seed) { m_RandomGenerator.seed(seed); }
+
+    /// Adds event ev with the weight ev.weight
+    void AddEvent(const SimpleEvent& ev);
+
+    /// Adds the values of the observables in an event with the given weight
+    void AddValues(const std::vector<double>& values, double weight = 1.);
+
+    /// Adds all events of another accumulator with the same configuration
+    void Merge(const EventCumulantAccumulator& other);
+
+    /// Number of observables
+    int NumberOfObservables() const { return m_NumberOfObservables; }
+
+    /// Highest order of the moments
+    int MaxOrder() const { return m_MaxOrder; }
+
+    /// Number of accumulated events
+    long long NumberOfEvents() const { return m_Sums.Events; }
+
+    /// Sum of the event weights
+    double SumOfWeights() const { return m_Sums.Moments[0]; }
+
+    /// Weighted mean of observable i
+    double Mean(int i) const { return Mean(i, m_Sums); }
+
+    /**
+     * \brief Weighted joint central moment
+     *
+     * \param indices Indices of the observables, e.g. {0,0,1} corresponds to
+     *                \f$ \langle (\delta X_0)^2 \delta X_1 \rangle \f$
+     */
+    double CentralMoment(const std::vector<int>& indices) const { return CentralMoment(indices, m_Sums); }
+
+    /**
+     * \brief Weighted joint cumulant
+     *
+     * \param indices Indices of the observables, e.g. {0,0,1} corresponds to
+     *                \f$ \kappa_{2,1} \f$ of observables 0 and 1
+     */
+    double Cumulant(const std::vector<int>& indices) const { return Cumulant(indices, m_Sums); }
+
+    /// Cumulant of order n of observable i
+    double Cumulant(int i, int n) const { return Cumulant(std::vector<int>(n, i)); }
+
+    /// Number of subsamples or bootstrap replicas
+    int NumberOfSamples() const { return static_cast<int>(m_Samples.size()); }
+
+    /// Joint cumulant evaluated in subsample (or bootstrap replica) isample
+    double SampleCumulant(const std::vector<int>& indices, int isample) const { return Cumulant(indices, m_Samples[isample]); }
+
+    /// Statistical error of the joint cumulant
+    double CumulantError(const std::vector<int>& indices) const;
+
+    /// Statistical error of the ratio of two joint cumulants.
+    /// Subsamples where the denominator vanishes are excluded from the estimate.
+    double CumulantRatioError(const std::vector<int>& numerator, const std::vector<int>& denominator) const;
+
+  private:
+    /// Weighted sums of the central moments over a set of events
+    struct MomentSums {
+      long long Events;
+      std::vector<double> Means;
+      std::vector<double> Moments;
+    };
+
+    /// Enumerates the multi-indices and the terms of the update formulas
+    void Initialize();
+
+    int MultiIndex(const std::vector<int>& exponents) const;
+
+    void AddPoint(MomentSums& sums, const double* values, double weight);
+    void MergeSums(MomentSums& sums, const MomentSums& other);
+
+    double Mean(int i, const MomentSums& sums) const;
+    double CentralMoment(const std::vector<int>& indices, const MomentSums& sums) const;
+    double Cumulant(const std::vector<int>& indices, const MomentSums& sums) const;
+
+    /// Error estimate from the values in the individual samples
+    double SampleError(const std::vector<double>& values) const;
+
+    bool CheckIndices(const std::vector<int>& indices) const;
+
+    int m_NumberOfObservables;
+    int m_MaxOrder;
+    ErrorEstimate m_ErrorEstimate;
+
+    std::vector<EventObservable> m_Observables;
+
+    MomentSums m_Sums;
+    std::vector<MomentSums> m_Samples;
+
+    /// Index of the next subsample
+    long long m_NextSample;
+
+    MTRand m_RandomGenerator;
+
+    /// Exponents of all multi-indices ordered by their total order
+    std::vector< std::vector<int> > m_Exponents;
+    std::map<long long, int> m_MultiIndices;
+
+    /// Multi-index with the exponent of the first non-zero component lowered by one, and this component
+    std::vector<int> m_Parent, m_ParentComponent;
+
+    /// The terms \f$ \binom{\alpha}{\beta} M_\beta \delta^{\alpha-\beta} \f$ of the update formulas for each multi-index
+    struct UpdateTerm {
+      int Beta;
+      int Gamma;
+      double Binomial;
+    };
+    std::vector< std::vector<UpdateTerm> > m_Terms;
+
+    std::vector<double> m_Values, m_PowersA, m_PowersB, m_Delta;
+  };
+
+} // namespace thermalfist
+
+#endif
@@ -14,6 +14,7 @@
 #include "HRGEventGenerator/SimpleEvent.h"
 #include "HRGEventGenerator/Acceptance.h"
 #include "HRGEventGenerator/RandomGenerators.h"
+#include "HRGEventGenerator/EVOverlapIndex.h"
 #include "HRGBase/xMath.h"
 #include "HRGBase/ThermalModelBase.h"
 
@@ -93,6 +94,10 @@ namespace thermalfist {
     /// Whether to use the SPR (single-particle rejection) approximation for the EV effects in coordinate space
     bool fUseEVUseSPRApproximation;
 
+    /// Whether to sample the totals of the (anti)strange, charged, and charmed mesons in the CE and SCE
+    /// directly from the conditional (Bessel) distributions instead of the Poisson rejection sampling
+    bool fUseCEConditionalSampling;
+
     /// Default configuration
     EventGeneratorConfiguration();
   };
@@ -183,11 +188,29 @@ namespace thermalfist {
     /**
      * \brief Performs decays of all unstable particles until only stable ones left.
      *
-     * \param evtin An event structure contains the list of all the primordial particles.
-     * \param TPS   Pointer to the particle list instance that contains all the decay properties.
-     * \return      A SimpleEvent instance containing all particles after resonance decays.
+     * \param evtin  An event structure contains the list of all the primordial particles.
+     * \param TPS    Pointer to the particle list instance that contains all the decay properties.
+     * \param filter If not NULL, only the final-state particles accepted by the filter are stored in SimpleEvent::Particles.
+     * \return       A SimpleEvent instance containing all particles after resonance decays.
      */
-    static SimpleEvent PerformDecays(const SimpleEvent& evtin, const ThermalParticleSystem* TPS);
+    static SimpleEvent PerformDecays(const SimpleEvent& evtin, const ThermalParticleSystem* TPS, const Acceptance::AcceptanceFilter* filter = NULL);
+
+    /**
+     * \brief Sets the filter applied to the final-state particles of generated events.
+     *
+     * The filter is applied in PerformDecays() as the stable particles are produced,
+     * or to the primordial particles if the decays are not performed.
+     * Primordial particles which cannot be accepted themselves, nor have any descendants
+     * which can be, are not sampled at all, unless the excluded-volume rejection in the coordinate
+     * space is used. Such particles do not appear in SimpleEvent::AllParticles either.
+     * Must be called after the generator is configured.
+     *
+     * \param filter Pointer to the filter, not owned. NULL removes the filter.
+     */
+    void SetAcceptanceFilter(const Acceptance::AcceptanceFilter* filter);
+
+    /// The filter applied to the final-state particles, NULL if none
+    const Acceptance::AcceptanceFilter* AcceptanceFilter() const { return m_AcceptanceFilter; }
 
     /**
      * \brief The grand-canonical mean yields.
@@ -198,7 +221,8 @@ namespace thermalfist {
 
     /// Helper variable to monitor the Acceptance rate of the rejection
     /// sampling used for canonical ensemble and/or eigenvolumes.
-    static int fCEAccepted, fCETotal;
+    /// Kept per generator instance, so that several generators can run in parallel.
+    mutable int fCEAccepted, fCETotal;
 
     /**
      * \brief Set system volume.
@@ -247,6 +271,9 @@ namespace thermalfist {
     /// Prepares the parameters of multinomial distribution used
     /// for sampling the yields in the canonical ensemble
     void PrepareMultinomials();
+
+    /// Removes the particles not accepted by the acceptance filter from SimpleEvent::Particles
+    void ApplyAcceptanceFilter(SimpleEvent& evt) const;
     
     /// Samples the multiplicities of all the
     /// particle species from the given statistical ensemble
@@ -263,9 +290,33 @@ namespace thermalfist {
     ///
     /// Uses rejection sampling, and the multi-step
     /// procedure from F. Becattini, L. Ferroni, Eur. Phys. J. **C38**, 225 (2004) [hep-ph/0407117]
+    ///
+    /// If EventGeneratorConfiguration::fUseCEConditionalSampling is set, each step
+    /// is instead accepted with the probability \f$ P(d) / \max_k P(k) \f$, where \f$ P \f$
+    /// is the Skellam distribution of the difference of the totals and \f$ d \f$ is the required difference,
+    /// and the totals are then sampled from the Bessel distribution.
+    /// This gives the same distribution with a higher acceptance rate.
     /// \return A vector of the sampled multiplicities
     std::vector<int> GenerateTotalsCE() const;
 
+    /**
+     * \brief Samples two Poisson numbers with the means mu1 and mu2
+     *        conditioned on their difference n1 - n2 = d.
+     *
+     * The step is accepted with the probability \f$ P(d) / P_{\rm max} \f$,
+     * where \f$ P \f$ is the Skellam distribution and \f$ P_{\rm max} = \exp(\textrm{logPmax}) \f$ its maximum.
+     * The numbers are then sampled from the Bessel distribution.
+     *
+     * \param d      The required difference n1 - n2
+     * \param mu1    Mean of the first Poisson number
+     * \param mu2    Mean of the second Poisson number
+     * \param logPmax Logarithm of the maximum of the Skellam distribution
+     * \param n1     The sampled first number
+     * \param n2     The sampled second number
+     * \return       Whether the step was accepted
+     */
+    static bool SampleConditionalTotals(int d, double mu1, double mu2, double logPmax, int& n1, int& n2);
+
     /// Samples the multiplicities of all the
     /// particle species from the strangeness-canonical ensemble
     ///
@@ -282,6 +333,22 @@ namespace thermalfist {
     /// \return A vector of the sampled multiplicities
     std::vector<int> GenerateTotalsSCESubVolume(double VolumeSC) const;
 
+    /**
+     * \brief Samples the strange hadrons in a sub-volume fraction * Vc of
+     *        a strangeness-canonical ensemble with volume Vc and adds them to totals.
+     *
+     * The hadrons with S > 0 are selected from the ensemble by binomial thinning.
+     * The hadrons with S < 0 are selected by binomial thinning conditioned on the
+     * zero net strangeness in the sub-volume: the numbers of selected hadrons for
+     * each |S| are sampled from their exact joint distribution, and then distributed
+     * among the species from the hypergeometric distribution.
+     *
+     * \param fraction The sub-volume fraction, between 0 and 1
+     * \param totals   The multiplicities to add the sampled hadrons to
+     * \return         False if the sampled ensemble cannot produce zero net strangeness in the sub-volume, in which case totals is not modified
+     */
+    bool SampleSCEFractionalSubVolume(double fraction, std::vector<int>& totals) const;
+
     /// Samples the multiplicities of all the
     /// particle species from the charm-canonical ensemble
     ///
@@ -359,11 +426,23 @@ namespace thermalfist {
     double m_MeanCHRMM, m_MeanACHRMM;
     double m_MeanCHRM, m_MeanACHRM;
 
-    std::vector<std::vector<double>> m_Radii;
+    /// Logarithms of the maxima of the Skellam distributions for the net numbers
+    /// of baryons, strange mesons, charged mesons, and charmed mesons
+    double m_SkellamLogMaxB, m_SkellamLogMaxS, m_SkellamLogMaxQ, m_SkellamLogMaxC;
+
+    /// The filter applied to the final-state particles
+    const Acceptance::AcceptanceFilter* m_AcceptanceFilter;
+
+    /// Whether the species or any of its descendants can be accepted by the filter
+    std::vector<bool> m_AcceptanceRelevant;
+
+    /// Excluded-volume radii for the rejection sampling in the coordinate space
+    EVRadiiTable m_Radii;
 
-    static double m_LastWeight;
-    static double m_LastLogWeight;
-    static double m_LastNormWeight;
+    /// Weights of the last generated configuration of totals
+    mutable double m_LastWeight;
+    mutable double m_LastLogWeight;
+    mutable double m_LastNormWeight;
   };
 
 } // namespace thermalfist
@@ -10,6 +10,7 @@
 
 //#include "HRGEventGenerator/RandomGenerators.h"
 #include <cmath>
+#include <vector>
 
 namespace thermalfist {
 
@@ -216,6 +217,57 @@ namespace thermalfist {
     double m_RoverTauH, m_tauH;
   };
 
+  /**
+   * \brief Tabulated boost-invariant freeze-out parametrization used in the Monte Carlo sampling.
+   *
+   * The functions R, dR/d\zeta, \tau, d\tau/d\zeta, and the transverse flow profile
+   * of a given BoostInvariantFreezeoutParametrization are evaluated once on a uniform \zeta grid
+   * and linearly interpolated, the \zeta distribution ZetaProbability() is
+   * taken as piecewise linear between the grid points and sampled by the inverse transform method,
+   * using a guide table for the search of the grid cell.
+   * The lookups involve no virtual function calls and no transcendental functions,
+   * a single table can be shared between the momentum generators of all particle species.
+   */
+  class BoostInvariantFreezeoutTable {
+  public:
+    /// Values of the freeze-out parametrization functions at a given \zeta
+    struct Point {
+      double R;            ///< Transverse radius
+      double dRdZeta;      ///< dR/d\zeta
+      double tau;          ///< Proper time \tau
+      double dtaudZeta;    ///< d\tau/d\zeta
+      double sinhetaperp;  ///< sinh of the transverse flow rapidity
+      double coshetaperp;  ///< cosh of the transverse flow rapidity
+      double tanhetaperp;  ///< Transverse flow velocity
+    };
+
+    /**
+     * \param model  The freeze-out parametrization to tabulate
+     * \param nzeta  Number of grid cells in \zeta
+     */
+    BoostInvariantFreezeoutTable(const BoostInvariantFreezeoutParametrization& model, int nzeta = 1000);
+
+    /// Interpolated values of the parametrization functions at a given \zeta
+    Point Interpolate(double zeta) const;
+
+    /// \zeta corresponding to the value xi in [0,1) of the cumulative \zeta distribution
+    double InverseZetaDistribution(double xi) const;
+
+    /// Number of grid cells in \zeta
+    int NumberOfCells() const { return m_Nzeta; }
+
+  private:
+    int m_Nzeta;
+    double m_dZeta;
+    std::vector<Point> m_Points;
+
+    /// Normalized \zeta probability density and the cumulative distribution at the grid points
+    std::vector<double> m_PDF, m_CDF;
+
+    /// The first grid cell with the cumulative distribution above k / m_Nzeta
+    std::vector<int> m_Guide;
+  };
+
 } // namespace thermalfist
 
 #endif
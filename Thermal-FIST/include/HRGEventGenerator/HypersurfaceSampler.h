@@ -32,16 +32,42 @@ namespace thermalfist {
     /**
       * \brief Sample the volume element on a hypersurface from a multinomial distribution
       *
+      * Uses Walker's alias method (Vose's construction), such that each draw
+      * costs O(1) irrespective of the number of volume elements.
+      * Negative weights are treated as zero.
+      *
       */
     class VolumeElementSampler {
-      std::vector<double> m_CumulativeProbabilities;
+      std::vector<double> m_Probabilities;
+      std::vector<int> m_Aliases;
     public:
       VolumeElementSampler(const ParticlizationHypersurface* Hypersurface = NULL);
       VolumeElementSampler(const std::vector<double>& Weights);
       void FillProbabilities(const ParticlizationHypersurface* Hypersurface);
       void FillProbabilities(const std::vector<double>& Weights);
-      void SetProbabilities(const std::vector<double>& CumulativeProbabilities) { m_CumulativeProbabilities = CumulativeProbabilities; }
+      
+      /// Sets the sampling probabilities from the cumulative distribution
+      void SetProbabilities(const std::vector<double>& CumulativeProbabilities);
+      
       int SampleVolumeElement(MTRand& rangen = RandomGenerators::randgenMT) const;
+
+      /// Number of volume elements
+      int Size() const { return static_cast<int>(m_Probabilities.size()); }
+    };
+
+
+    /**
+     * \brief Structure-of-arrays storage of the phase-space coordinates
+     *        of a batch of particles sampled from a hypersurface.
+     *
+     */
+    struct PhaseSpaceCoordinatesBatch {
+      std::vector<double> px, py, pz;
+      std::vector<double> r0, rx, ry, rz;
+
+      size_t size() const { return px.size(); }
+      void resize(size_t n);
+      void clear() { resize(0); }
     };
 
 
@@ -76,6 +102,29 @@ namespace thermalfist {
         const double& etasmear = 0.
       );
 
+      /**
+       * \brief Samples the Cartesian phase-space coordinates of a batch of particles of the same species.
+       *
+       * Same as SamplePhaseSpaceCoordinateFromElement() but processes all the particles at once.
+       * The thermal momentum generators are set up once per distinct (T,mu) pair among the elements,
+       * while the boosts and the Cooper-Frye weights are evaluated over contiguous arrays.
+       *
+       * \param hypersurface    Pointer to a ParticlizationHypersurface object.
+       * \param elements        Indices of the volume elements, one per particle.
+       * \param particle        Pointer to a ThermalParticle object representing the particle to sample.
+       * \param batch           The sampled coordinates, in the same order as \p elements.
+       * \param mass            Particle mass in GeV. If negative, the pole/vacuum mass is used.
+       * \param etasmear        The smear in longitudinal rapidity
+       */
+      static void SamplePhaseSpaceCoordinatesFromElements(
+        const ParticlizationHypersurface* hypersurface,
+        const std::vector<int>& elements,
+        const ThermalParticle* particle,
+        PhaseSpaceCoordinatesBatch& batch,
+        double mass = -1.,
+        double etasmear = 0.
+      );
+
       /**
        * \brief Construct a new BoostInvariantMomentumGenerator object
        *
@@ -83,12 +132,14 @@ namespace thermalfist {
        * \param particle        Pointer to a ThermalParticle object. Not deleted on destruction!
        * \param positionsampler Pointer to a VolumeElementSampler object. Not deleted on destruction!
        * \param etasmear        The smear in longitudinal rapidity
+       * \param batchsize       Number of particles sampled at once for the pole mass. No batching if less than 2.
        */
       HypersurfaceMomentumGenerator(
         const ParticlizationHypersurface* hypersurface = NULL,
         const ThermalParticle* particle = NULL,
         const VolumeElementSampler* positionsampler = NULL,
-        double etasmear = 0.0);
+        double etasmear = 0.0,
+        int batchsize = 1);
 
       /**
        * \brief BoostInvariantMomentumGenerator desctructor.
@@ -99,9 +150,11 @@ namespace thermalfist {
 
       double EtaSmear() const { return m_EtaSmear; }
       double Mass() const { return m_Particle->Mass(); }
+      int BatchSize() const { return m_BatchSize; }
 
       // Override functions begin
 
+      /// Particles with the pole mass are taken from a buffer which is refilled batch-wise
       virtual std::vector<double> GetMomentum(double mass = -1.) const;
 
       // Override functions end
@@ -116,6 +169,11 @@ namespace thermalfist {
       //ThermalMomentumGenerator m_Generator;
       //double m_Tkin;
       double m_EtaSmear;
+      int m_BatchSize;
+
+      mutable PhaseSpaceCoordinatesBatch m_Buffer;
+      mutable std::vector<int> m_BufferElements;
+      mutable size_t m_BufferPosition;
     };
 
 
@@ -203,6 +261,8 @@ namespace thermalfist {
       SetHypersurface(hypersurface);
       SetEtaSmear(etasmear);
       SetRescaleTmu();
+      SetSamplerSharingTolerance();
+      SetMomentumBatchSize();
       m_THM = model;
       //SetParameters(hypersurface, model, etasmear);
     }
@@ -241,8 +301,35 @@ namespace thermalfist {
     void SetEtaSmear(double etaSmear) { m_EtaSmear = etaSmear; m_ParametersSet = false; }
     double GetEtaSmear() const { return m_EtaSmear; }
 
+    /**
+     * \brief Sets the number of particles of each species whose momenta are sampled at once
+     *
+     * See RandomGenerators::HypersurfaceMomentumGenerator::SamplePhaseSpaceCoordinatesFromElements().
+     * Only applies to particles sampled with the pole mass.
+     *
+     * \param batchSize The batch size. No batching if less than 2.
+     */
+    void SetMomentumBatchSize(int batchSize = 256) { m_MomentumBatchSize = batchSize; m_ParametersSet = false; }
+    int GetMomentumBatchSize() const { return m_MomentumBatchSize; }
+
     void SetRescaleTmu(bool rescale = false, double edens = 0.26);
 
+    /**
+     * \brief Sets the tolerance for sharing the volume element samplers between species
+     *
+     * Species which have the same statistics, conserved charges, and a similar mass
+     * share a single VolumeElementSampler if their volume element weights
+     * are proportional to each other within the relative tolerance \p tol.
+     * A negative value disables the sharing.
+     *
+     * \param tol Relative tolerance (default: 1.e-9)
+     */
+    void SetSamplerSharingTolerance(double tol = 1.e-9) { m_SamplerSharingTolerance = tol; m_ParametersSet = false; }
+    double GetSamplerSharingTolerance() const { return m_SamplerSharingTolerance; }
+
+    /// Number of distinct volume element samplers in use
+    int VolumeElementSamplersNumber() const { return static_cast<int>(m_VolumeElementSamplers.size()); }
+
     /// Sets the hypersurface parameters
     //void SetParameters(const ParticlizationHypersurface* hypersurface, ThermalModelBase* model, double etasmear = 0.0);
     //virtual void SetParameters();
@@ -280,12 +367,18 @@ namespace thermalfist {
 
     /// The computed grand-canonical yields in 4pi
     const std::vector<double>& FullSpaceYields() const { return m_FullSpaceYields; }
+
+    /// Groups species with proportional volume element weights and constructs one sampler per group
+    void SetVolumeElementSamplers(std::vector< std::vector<double> >& allweights);
     
     //bool m_ParametersSet;
 
   private:
     const ParticlizationHypersurface* m_ParticlizationHypersurface;
     std::vector<RandomGenerators::VolumeElementSampler> m_VolumeElementSamplers;
+    std::vector<int> m_VolumeElementSamplerIndex;
+    double m_SamplerSharingTolerance;
+    int m_MomentumBatchSize;
     std::vector<double> m_FullSpaceYields;
     double m_EtaSmear;
     double m_Tav;
@@ -0,0 +1,117 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#ifndef MULTIPLICITYCLASSEVENTGENERATOR_H
+#define MULTIPLICITYCLASSEVENTGENERATOR_H
+
+#include <vector>
+
+#include "HRGEventGenerator/CylindricalBlastWaveEventGenerator.h"
+
+namespace thermalfist {
+
+  /**
+   * \brief Thermal and blast-wave parameters of a single multiplicity class.
+   */
+  struct MultiplicityClass {
+    double dNchdEta;    ///< Charged particle multiplicity \f$ dN_{\rm ch}/d\eta \f$ of the class (used as a label)
+    double V;           ///< Volume (in fm^3)
+    double Vc;          ///< Canonical correlation volume (in fm^3), the same as V if non-positive
+    double T;           ///< Chemical freeze-out temperature (in GeV)
+    double gammaS;      ///< Strangeness saturation factor
+    double Tkin;        ///< Kinetic freeze-out temperature (in GeV)
+    double betaT;       ///< Mean transverse flow velocity
+    double n;           ///< Power in the transverse flow profile function
+    double etamax;      ///< The longitudinal space-time rapidity cut-off
+    long long nevents;  ///< Number of events to generate
+
+    MultiplicityClass(double dNchdEta_ = 0., double V_ = 100., double T_ = 0.155, double gammaS_ = 1.,
+      double Tkin_ = 0.155, double betaT_ = 0., double n_ = 1., long long nevents_ = 0, double etamax_ = 0.5, double Vc_ = 0.) :
+      dNchdEta(dNchdEta_), V(V_), Vc(Vc_), T(T_), gammaS(gammaS_), Tkin(Tkin_), betaT(betaT_), n(n_), etamax(etamax_), nevents(nevents_) { }
+  };
+
+  /**
+   * \brief Generates events for a scan over multiplicity classes.
+   *
+   * For each class a CylindricalBlastWaveEventGenerator is set up once in the constructor,
+   * all generators use the same particle list. The thermal parameters of each class
+   * (T, \f$ \gamma_S \f$, V, \f$ V_c \f$) replace the corresponding entries
+   * of the common configuration, other settings (ensemble, conserved charges, excluded volume)
+   * are shared between the classes.
+   *
+   * Run() generates the events of all classes. If the library is built with OpenMP (USE_OpenMP)
+   * the classes are processed in parallel, in the order of decreasing expected cost
+   * (the number of events times the mean number of primordial hadrons),
+   * and each free thread picks the next class. The random number generator
+   * is re-seeded at the start of each class, the result therefore does not depend on the number of threads.
+   *
+   */
+  class MultiplicityClassEventGenerator
+  {
+  public:
+    /**
+     * \brief Handler of the generated events.
+     *
+     * ProcessEvent() is called sequentially for the events of a given class,
+     * but can be called concurrently from different threads for different classes.
+     */
+    class EventHandler {
+    public:
+      virtual ~EventHandler() { }
+
+      /// Processes event number ievent of class iclass
+      virtual void ProcessEvent(int iclass, long long ievent, const SimpleEvent& ev) = 0;
+    };
+
+    /**
+     * \brief Construct a new MultiplicityClassEventGenerator object
+     *
+     * \param TPS     A pointer to the particle list
+     * \param config  Common event generator configuration
+     * \param classes The table of multiplicity classes
+     */
+    MultiplicityClassEventGenerator(ThermalParticleSystem* TPS, const EventGeneratorConfiguration& config, const std::vector<MultiplicityClass>& classes);
+
+    ~MultiplicityClassEventGenerator();
+
+    /// Number of multiplicity classes
+    int NumberOfClasses() const { return static_cast<int>(m_Classes.size()); }
+
+    /// Parameters of class iclass
+    const MultiplicityClass& Class(int iclass) const { return m_Classes[iclass]; }
+
+    /// Event generator of class iclass
+    CylindricalBlastWaveEventGenerator* Generator(int iclass) { return m_Generators[iclass]; }
+
+    /// Expected cost of generating all events of class iclass, in units of the number of primordial hadrons
+    double ExpectedCost(int iclass) const { return m_ExpectedCosts[iclass]; }
+
+    /// Number of threads used by Run(), non-positive value corresponds to all available threads
+    void SetNumberOfThreads(int nthreads) { m_NumberOfThreads = nthreads; }
+
+    /// Seed of the random number generator in class iclass is seed + iclass, zero corresponds to the seed drawn from RandomGenerators::randgenMT
+    void SetSeed(unsigned int seed) { m_Seed = seed; }
+
+    /**
+     * \brief Generates the events of all the classes
+     *
+     * \param handler       Handler of the generated events
+     * \param performDecays Whether the decays of unstable resonances are performed
+     */
+    void Run(EventHandler* handler, bool performDecays = true);
+
+  private:
+    std::vector<MultiplicityClass> m_Classes;
+    std::vector<CylindricalBlastWaveEventGenerator*> m_Generators;
+    std::vector<double> m_ExpectedCosts;
+    int m_NumberOfThreads;
+    unsigned int m_Seed;
+  };
+
+} // namespace thermalfist
+
+#endif
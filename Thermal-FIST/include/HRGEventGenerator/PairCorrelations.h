@@ -0,0 +1,165 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#ifndef PAIRCORRELATIONS_H
+#define PAIRCORRELATIONS_H
+
+#include <vector>
+#include <map>
+#include <deque>
+
+#include "HRGEventGenerator/SimpleEvent.h"
+
+namespace thermalfist {
+
+  /**
+   * \brief On-line accumulator of two-particle correlations in relative rapidity and azimuth
+   *        and of the balance function between two sets of species.
+   *
+   * The pairs are formed between the particles of set A (e.g. \f$ \Xi^- \f$)
+   * and of set B (e.g. \f$ \pi^+ \f$, \f$ \pi^- \f$), the antiparticles of the
+   * species in set A (B) form set \f$ \bar{A} \f$ (\f$ \bar{B} \f$).
+   * The same-event and mixed-event pair distributions in \f$ (\Delta y, \Delta \phi) \f$,
+   * \f$ \Delta y = y_b - y_a \f$, \f$ \Delta \phi = \phi_b - \phi_a \in [-\pi/2, 3\pi/2) \f$,
+   * are accumulated for each of the four combinations AB, \f$ A\bar{B} \f$, \f$ \bar{A}B \f$, \f$ \bar{A}\bar{B} \f$.
+   *
+   * In each event the particles of the selected species are first sorted into the four
+   * sets, the pairing thus costs \f$ O(n_a n_b) \f$ operations and is independent of the total multiplicity.
+   * The mixed-event pairs are formed between set A (\f$ \bar{A} \f$) of the current event and
+   * sets B, \f$ \bar{B} \f$ of the previous MixingDepth() events.
+   *
+   * Accumulators with the same configuration filled in different threads
+   * can be combined with Merge().
+   *
+   */
+  class PairCorrelationAccumulator
+  {
+  public:
+    /// Combinations of the particle sets
+    enum PairType {
+      AB = 0,       ///< Set A and set B
+      ABbar = 1,    ///< Set A and antiparticles of set B
+      AbarB = 2,    ///< Antiparticles of set A and set B
+      AbarBbar = 3  ///< Antiparticles of set A and antiparticles of set B
+    };
+
+    /**
+     * \brief Construct a new PairCorrelationAccumulator object
+     *
+     * \param speciesA    PDG codes of the particles in set A
+     * \param speciesB    PDG codes of the particles in set B
+     * \param nbinsDy     Number of bins in \f$ \Delta y \f$
+     * \param dymax       The range \f$ -\Delta y_{\rm max} < \Delta y < \Delta y_{\rm max} \f$
+     * \param nbinsDphi   Number of bins in \f$ \Delta \phi \f$
+     * \param mixingDepth Number of previous events used for the event mixing
+     */
+    PairCorrelationAccumulator(const std::vector<long long>& speciesA, const std::vector<long long>& speciesB,
+      int nbinsDy = 40, double dymax = 2., int nbinsDphi = 36, int mixingDepth = 5);
+
+    /// Removes all accumulated pairs and the events in the mixing pool
+    void Clear();
+
+    /// Adds the pairs from the final state particles of event ev, with the weight ev.weight
+    void AddEvent(const SimpleEvent& ev);
+
+    /// Adds the pairs of another accumulator with the same configuration, the mixing pools are not merged
+    void Merge(const PairCorrelationAccumulator& other);
+
+    /// Number of accumulated events
+    long long NumberOfEvents() const { return m_NumberOfEvents; }
+
+    /// Sum of the event weights
+    double SumOfWeights() const { return m_SumOfWeights; }
+
+    /// Weighted number of particles in set A (anti = false) or \f$ \bar{A} \f$ (anti = true)
+    double TriggerCount(bool anti = false) const { return m_TriggerCounts[anti ? 1 : 0]; }
+
+    /// Weighted number of particles in set A (anti = false) or \f$ \bar{A} \f$ (anti = true) used in the mixed-event pairs
+    double MixedTriggerCount(bool anti = false) const { return m_MixedTriggerCounts[anti ? 1 : 0]; }
+
+    /// Number of bins in \f$ \Delta y \f$
+    int NumberOfBinsDy() const { return m_NbinsDy; }
+
+    /// Number of bins in \f$ \Delta \phi \f$
+    int NumberOfBinsDphi() const { return m_NbinsDphi; }
+
+    /// Number of previous events used for the event mixing
+    int MixingDepth() const { return m_MixingDepth; }
+
+    /// Center of \f$ \Delta y \f$ bin iy
+    double DyBinCenter(int iy) const { return -m_DyMax + (iy + 0.5) * m_BinWidthDy; }
+
+    /// Center of \f$ \Delta \phi \f$ bin iphi
+    double DphiBinCenter(int iphi) const;
+
+    /// Weighted number of same-event pairs of a given type in bin (iy, iphi)
+    double SameEventPairs(PairType type, int iy, int iphi) const { return m_Same[type][iy * m_NbinsDphi + iphi]; }
+
+    /// Weighted number of mixed-event pairs of a given type in bin (iy, iphi)
+    double MixedEventPairs(PairType type, int iy, int iphi) const { return m_Mixed[type][iy * m_NbinsDphi + iphi]; }
+
+    /**
+     * \brief Correlation function \f$ C(\Delta y, \Delta \phi) \f$ of a given type in bin (iy, iphi)
+     *
+     * The ratio of the same-event and the mixed-event pair distributions,
+     * each normalized per particle of set A (\f$ \bar{A} \f$).
+     * Returns zero if there are no mixed-event pairs in the bin.
+     */
+    double Correlation(PairType type, int iy, int iphi) const;
+
+    /**
+     * \brief Balance function \f$ B(\Delta y) \f$ in \f$ \Delta y \f$ bin iy
+     *
+     * \f$ B(\Delta y) = \frac{1}{2} \left[ \frac{N_{A\bar{B}} - N_{AB}}{N_A} + \frac{N_{\bar{A}B} - N_{\bar{A}\bar{B}}}{N_{\bar{A}}} \right] \f$
+     * per unit \f$ \Delta y \f$, from the same-event pairs integrated over \f$ \Delta \phi \f$.
+     *
+     * \param mixedSubtracted Whether the mixed-event pair distributions are subtracted from the same-event ones
+     */
+    double BalanceFunction(int iy, bool mixedSubtracted = false) const;
+
+  private:
+    /// Rapidity and azimuth of a particle, and its index in the event
+    struct Track {
+      double y, phi;
+      int index;
+    };
+
+    /// Set A, set \f$ \bar{A} \f$, set B, set \f$ \bar{B} \f$
+    typedef std::vector<Track> TrackSets[4];
+
+    void FillPairs(const std::vector<Track>& tracksA, const std::vector<Track>& tracksB, bool sameEvent, double weight, std::vector<double>& hist) const;
+
+    /// Pair density per particle of set A or \f$ \bar{A} \f$ in \f$ \Delta y \f$ bin iy
+    double PairDensity(const std::vector<double>& hist, double triggers, int iy) const;
+
+    /// Membership of each PDG code in the four sets as a bit mask
+    std::map<long long, int> m_SpeciesMask;
+
+    int m_NbinsDy;
+    double m_DyMax;
+    double m_BinWidthDy;
+    int m_NbinsDphi;
+    double m_BinWidthDphi;
+    int m_MixingDepth;
+
+    long long m_NumberOfEvents;
+    double m_SumOfWeights;
+    double m_TriggerCounts[2];
+    double m_MixedTriggerCounts[2];
+
+    std::vector<double> m_Same[4];
+    std::vector<double> m_Mixed[4];
+
+    TrackSets m_Tracks;
+
+    /// Sets B and \f$ \bar{B} \f$ of the previous events
+    std::deque< std::vector<Track> > m_PoolB, m_PoolBbar;
+  };
+
+} // namespace thermalfist
+
+#endif
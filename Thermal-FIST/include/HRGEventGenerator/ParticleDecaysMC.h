@@ -45,8 +45,27 @@ namespace thermalfist {
      */
     double TernaryThreeBodym12Maximum(double M, double m1, double m2, double m3);
 
+    /**
+     * \brief Upper bound on the maximum of the \f$m_{12}\f$ probability density function
+     *        used in a three-body decay, taken from a cached table.
+     *
+     * The maximum is a monotonically increasing function of the mother mass.
+     * For each set of daughter masses it is tabulated with TernaryThreeBodym12Maximum()
+     * on a geometric grid in the kinetic energy release \f$M - m_1 - m_2 - m_3\f$, filled on demand,
+     * and the value at the nearest grid point above \f$M\f$ is returned.
+     * The bound thus exceeds the exact maximum by at most about 1%.
+     *
+     * \param M   Mass of the decaying particle
+     * \param m1  Mass of the first daughter particle
+     * \param m2  Mass of the second daughter particle
+     * \param m3  Mass of the third daughter particle
+     * \return    Upper bound on the maximum of the \f$m_{12}\f$ probability density function
+     */
+    double ThreeBodym12MaximumCached(double M, double m1, double m2, double m3);
+
     /// Used for debugging the succes rate in the rejection sampling of \f$m_{12}\f$.
-    extern int threebodysucc, threebodytot;
+    /// Counted separately in each thread.
+    extern thread_local int threebodysucc, threebodytot;
 
     /**
      * \brief Sample the invariant mass \f$m_{12}\f$ of the leading two
@@ -108,36 +127,61 @@ namespace thermalfist {
      */
     std::vector<SimpleParticle> TwoBodyDecay(const SimpleParticle & Mother, double m1, long long pdg1, double m2, long long pdg2);
     
+    /// Maximum number of decay products handled with fixed-size buffers on the stack in NBodyPhaseSpace()
+    const int MaxNBodyStackSize = 16;
+
+    /**
+     * \brief Samples the four-momenta of an N-body decay uniformly in the phase space,
+     *        in the rest frame of the decaying particle.
+     *
+     * Uses the GENBOD algorithm (F. James, CERN-68-15): the invariant masses of
+     * the successive subsystems are sampled uniformly and the resulting weighted
+     * configurations are unweighted by rejection. Does not allocate memory
+     * for up to MaxNBodyStackSize decay products.
+     *
+     * \param M       Mass of the decaying particle (in GeV)
+     * \param n       Number of the decay products
+     * \param masses  Masses of the decay products (in GeV), array of size n
+     * \param momenta Output four-momenta (p0, px, py, pz) of the decay products, array of size 4n
+     */
+    void NBodyPhaseSpace(double M, int n, const double* masses, double* momenta);
+
     /**
      * \brief Samples the decay products of a many-body decay.
      * 
-     * ---
-     * **NOTE**
-     * 
-     * While the decay kinematics of a three-body decay here are exact,
-     * decay kinematics for (4+)-body decays are approximate and should
-     * be taken into consideration.
-     * 
-     * ---
+     * Three-body decays use the exact sampling of \f$m_{12}\f$ with cached maxima,
+     * (4+)-body decays are sampled uniformly in the phase space with NBodyPhaseSpace().
      * 
      * \param Mother The decaying particle
      * \param masses Masses of the decay products (in GeV)
      * \param pdgs   Pdg codes of the decay products
      * \return std::vector<SimpleParticle> 
      */
-    std::vector<SimpleParticle> ManyBodyDecay(const SimpleParticle & Mother, std::vector<double> masses, std::vector<long long> pdgs); // TODO: proper implementation for 4+ - body decays
+    std::vector<SimpleParticle> ManyBodyDecay(const SimpleParticle & Mother, const std::vector<double>& masses, const std::vector<long long>& pdgs);
+
+    /**
+     * \brief Same as ManyBodyDecay() but writes the decay products into
+     *        the provided vector to avoid the allocations.
+     *
+     * \param Mother        The decaying particle
+     * \param masses        Masses of the decay products (in GeV)
+     * \param pdgs          Pdg codes of the decay products
+     * \param decayProducts Output vector of the decay products (overwritten)
+     */
+    void ManyBodyDecay(const SimpleParticle & Mother, const std::vector<double>& masses, const std::vector<long long>& pdgs, std::vector<SimpleParticle>& decayProducts);
 
 
     /**
      * \brief Shuffles the decay products.
      *        
-     * Currently used for four+ body decays to avoid having asymmetry in 
-     * momentum distributions of decay products due to non-exact current implementation of these decays.
+     * Was used for four+ body decays to avoid having asymmetry in 
+     * momentum distributions of decay products due to the approximate implementation of these decays.
+     * Not needed anymore since NBodyPhaseSpace() is symmetric in the decay products.
      *
      * \param masses Masses of the decay products (in GeV)
      * \param pdgs   Pdg codes of the decay products
      */
-    void ShuffleDecayProducts(std::vector<double> &masses, std::vector<long long> &pdgs); // TODO: proper implementation for 4+ - body decays
+    void ShuffleDecayProducts(std::vector<double> &masses, std::vector<long long> &pdgs);
   
     
     /**
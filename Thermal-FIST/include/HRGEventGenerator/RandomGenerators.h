@@ -10,6 +10,7 @@
 
 #include <cmath>
 
+#include "ThermalFISTConfig.h"
 #include "MersenneTwister.h"
 #include "HRGEventGenerator/MomentumDistribution.h"
 #include "HRGBase/ThermalParticle.h"
@@ -21,7 +22,13 @@ namespace thermalfist {
   namespace RandomGenerators {
 
     /// \brief The Mersenne Twister random number generator
+    ///
+    /// With OpenMP each thread has its own instance
+#ifdef ThermalFIST_USE_OPENMP
+    extern thread_local MTRand randgenMT;
+#else
     extern MTRand randgenMT;
+#endif
 
     /// \brief Set the seed of the random number generator randgenMT
     void SetSeed(const unsigned int seed);
@@ -37,10 +44,35 @@ namespace thermalfist {
     /// \param rangen A Mersenne Twister random number generator to use
     int RandomPoisson(double mean, MTRand &rangen);
 
+    /// \brief Generates random integer distributed by the binomial distribution
+    ///        with n trials and success probability p
+    ///
+    /// Inversion starting from the mode, the expected cost grows as \f$\sqrt{n p (1-p)}\f$.
+    /// Uses randgenMT
+    int RandomBinomial(int n, double p);
+
+    /// \brief Same as RandomBinomial(int, double) but uses the provided instance
+    ///        of the  Mersenne Twister random number generator
+    int RandomBinomial(int n, double p, MTRand &rangen);
+
+    /// \brief Generates the number of successes in the given number of draws without replacement
+    ///        from a population containing the given number of successes (hypergeometric distribution)
+    ///
+    /// Uses randgenMT
+    int RandomHypergeometric(int draws, int successes, int population);
+
     /// \brief Probability of a Skellam distributed random variable with Poisson means
     ///        mu1 and mu2 to have the value of k.
     double SkellamProbability(int k, double mu1, double mu2);
 
+    /// \brief Logarithm of SkellamProbability(), does not overflow for large mu1 and mu2.
+    ///        Returns a large negative number if the probability is zero.
+    double SkellamLogProbability(int k, double mu1, double mu2);
+
+    /// \brief Most probable value of a Skellam distributed random variable with Poisson means
+    ///        mu1 and mu2.
+    int SkellamMode(double mu1, double mu2);
+
 
     /// \brief Generator of a random number from the Bessel distribution (a, nu), nu is integer
     ///        Uses methods from https://www.sciencedirect.com/science/article/pii/S016771520200055X
@@ -304,19 +336,24 @@ namespace thermalfist {
        * \brief Construct a new BoostInvariantMomentumGenerator object
        *
        * \param FreezeoutModel Pointer to a BoostInvariantFreezeoutParametrization object. Will be deleted on destruction!
+       *                       Can be NULL if FreezeoutTable is provided, in which case all sampling uses the table.
        * \param Tkin       The kinetic temperature (in GeV)
        * \param etamax     The longitudinal space-time rapidity cut-off
        * \param mass       Particle mass (in GeV)
        * \param statistics Quantum statistics (default: Maxwell-Boltzmann)
        * \param mu         Chemical potential (in GeV). Only matters for quantum statistics
+       * \param FreezeoutTable Tabulated freeze-out parametrization used in the sampling, e.g. shared between species.
+       *                       Not owned by the generator. If NULL, the table is built from FreezeoutModel.
        */
       BoostInvariantMomentumGenerator(BoostInvariantFreezeoutParametrization* FreezeoutModel = NULL,
-        double Tkin = 0.100, double etamax = 3.0, double mass = 0.938, int statistics = 0, double mu = 0);
+        double Tkin = 0.100, double etamax = 3.0, double mass = 0.938, int statistics = 0, double mu = 0,
+        const BoostInvariantFreezeoutTable* FreezeoutTable = NULL);
 
       /**
        * \brief BoostInvariantMomentumGenerator desctructor.
        *
-       * Will free the memory used by the object pointed to by m_FreezeoutModel
+       * Will free the memory used by the object pointed to by m_FreezeoutModel,
+       * and the freeze-out table if it was built by the generator
        */
       virtual ~BoostInvariantMomentumGenerator();
 
@@ -333,13 +370,16 @@ namespace thermalfist {
      /**
      * \brief Samples zeta for use in Monte Carlo event generator.
      *
-     * Uses rejection sampling.
+     * Uses the explicit inverse of the zeta distribution if the freeze-out parametrization provides one,
+     * otherwise the inverse transform of the tabulated zeta distribution.
      *
      */
      virtual double GetRandomZeta(MTRand& rangen = RandomGenerators::randgenMT) const;
 
     private:
       BoostInvariantFreezeoutParametrization* m_FreezeoutModel;
+      const BoostInvariantFreezeoutTable* m_FreezeoutTable;
+      bool m_OwnFreezeoutTable;
       ThermalMomentumGenerator m_Generator;
       double m_Tkin;
       double m_EtaMax;
@@ -0,0 +1,95 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#ifndef ROOTEVENTWRITER_H
+#define ROOTEVENTWRITER_H
+
+#include <string>
+#include <vector>
+
+#include "HRGBase/ThermalParticleSystem.h"
+#include "EventWriter.h"
+
+class TFile;
+class TTree;
+
+namespace thermalfist {
+
+  /// \brief Writes the events to a ROOT TTree with flat branches of vectors of primitive types
+  ///
+  /// Each entry of the tree corresponds to one event. The particle branches are
+  /// pdg, charge (int16), pt, y, eta, phi, m (float) and optionally
+  /// r0, rx, ry, rz (float), mother (mother pdg), and epoch (int16),
+  /// the event branches are weight and logweight (double).
+  /// No TObject-derived classes are stored, the file can be read without
+  /// any Thermal-FIST dictionaries.
+  ///
+  /// The electric charges are taken from the particle list, the charges of photons
+  /// and leptons are set explicitly.
+  ///
+  /// The writer is available if Thermal-FIST is compiled with the ROOT Tree
+  /// library (USE_ROOT_TREE), otherwise OpenFile() always fails.
+  class RootEventWriter
+    : public EventWriter
+  {
+  public:
+    /**
+     * \brief Construct a new RootEventWriter object
+     *
+     * \param filename    Output file name
+     * \param TPS         Particle list used to determine the electric charges
+     * \param config      Which optional branches to write (coordinates, mother pdg, decay epoch, photons/leptons)
+     * \param compression ROOT compression setting of the file (100 * algorithm + level)
+     * \param basketSize  Basket size of the branches (in bytes)
+     * \param treeName    Name of the tree
+     */
+    RootEventWriter(const std::string& filename = "",
+      const ThermalParticleSystem* TPS = NULL,
+      const SimpleEvent::EventOutputConfig& config = SimpleEvent::EventOutputConfig(),
+      int compression = 101,
+      int basketSize = 32000,
+      const std::string& treeName = "events");
+
+    virtual ~RootEventWriter();
+
+    virtual bool OpenFile(const std::string& filename);
+
+    virtual void CloseFile();
+
+    virtual bool WriteEvent(const SimpleEvent& evt);
+
+    /// Whether the library was compiled with the ROOT Tree support
+    static bool Available();
+
+    /// The output tree, can be used to add user branches before the first event is written
+    TTree* Tree() { return m_Tree; }
+
+  private:
+    void AddParticle(const SimpleParticle& part);
+
+    /// Electric charge of a particle with a given pdg code
+    int Charge(long long pdgid) const;
+
+    const ThermalParticleSystem* m_TPS;
+    SimpleEvent::EventOutputConfig m_Config;
+    int m_Compression;
+    int m_BasketSize;
+    std::string m_TreeName;
+
+    TFile* m_File;
+    TTree* m_Tree;
+
+    double m_Weight, m_LogWeight;
+    std::vector<int> m_PDG, m_MotherPDG;
+    std::vector<short> m_Charge, m_Epoch;
+    std::vector<float> m_Pt, m_Y, m_Eta, m_Phi, m_M;
+    std::vector<float> m_R0, m_Rx, m_Ry, m_Rz;
+  };
+
+} // namespace thermalfist
+
+#endif
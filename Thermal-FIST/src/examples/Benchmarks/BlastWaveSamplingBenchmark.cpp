@@ -0,0 +1,57 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include <iostream>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include "HRGBase.h"
+#include "HRGEventGenerator.h"
+
+#include "ThermalFISTConfig.h"
+
+using namespace std;
+
+#ifdef ThermalFIST_USENAMESPACE
+using namespace thermalfist;
+#endif
+
+// Measures the sampling rate of particle momenta and coordinates in the cylindrical blast-wave model
+// for pions, kaons, and protons, as well as the mean transverse momenta and radii
+// Usage: BlastWaveSamplingBenchmark <nparticles>
+int main(int argc, char *argv[])
+{
+  int nparticles = 1000000;
+  if (argc > 1)
+    nparticles = atoi(argv[1]);
+
+  const double Tkin = 0.100, betaS = 0.8, etamax = 1.0, npow = 0.5;
+  const double masses[3] = { 0.13957, 0.493677, 0.938272 };
+  const char* names[3] = { "pi", "K", "p" };
+
+  RandomGenerators::SetSeed(1);
+  for (int ipart = 0; ipart < 3; ++ipart) {
+    RandomGenerators::BoostInvariantMomentumGenerator generator(
+      new CylindricalBlastWaveParametrization(betaS, npow, 10., 6.),
+      Tkin, etamax, masses[ipart]);
+
+    double ptsum = 0., rsum = 0.;
+    clock_t start = clock();
+    for (int i = 0; i < nparticles; ++i) {
+      vector<double> mom = generator.GetMomentum();
+      ptsum += sqrt(mom[0] * mom[0] + mom[1] * mom[1]);
+      rsum += sqrt(mom[4] * mom[4] + mom[5] * mom[5]);
+    }
+    double time = (clock() - start) / (double)CLOCKS_PER_SEC;
+    printf("%2s: %8.3lf M particles/s  <pT> = %8.5lf GeV  <r> = %8.5lf fm\n",
+      names[ipart], 1.e-6 * nparticles / time, ptsum / nparticles, rsum / nparticles);
+  }
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include <iostream>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include "HRGBase.h"
+#include "HRGEventGenerator.h"
+
+#include "ThermalFISTConfig.h"
+
+using namespace std;
+
+#ifdef ThermalFIST_USENAMESPACE
+using namespace thermalfist;
+#endif
+
+// Compares the Poisson rejection sampling and the conditional (Bessel) sampling
+// of the multiplicities in the canonical ensemble for small systems:
+// acceptance rate, time, and the mean and variance of the Xi- and Omega multiplicities.
+// Then does the same for the strangeness-canonical ensemble with different ratios V/Vc
+// Usage: CESamplingBenchmark <nevents>
+int main(int argc, char *argv[])
+{
+  int nevents = 20000;
+  if (argc > 1)
+    nevents = atoi(argv[1]);
+
+  ThermalParticleSystem parts(ThermalFIST_DEFAULT_LIST_FILE);
+  ThermalModelIdeal model(&parts);
+  model.SetTemperature(0.155);
+  model.SetBaryonChemicalPotential(0.);
+  model.SetElectricChemicalPotential(0.);
+  model.SetStrangenessChemicalPotential(0.);
+
+  int idXi = parts.PdgToId(3312), idOmega = parts.PdgToId(3334);
+
+  double Radii[] = { 1.5, 2., 3., 4. };
+  for (int iR = 0; iR < 4; ++iR) {
+    model.SetVolumeRadius(Radii[iR]);
+
+    for (int mode = 0; mode < 2; ++mode) {
+      EventGeneratorConfiguration config;
+      config.fEnsemble = EventGeneratorConfiguration::CE;
+      config.fModelType = EventGeneratorConfiguration::PointParticle;
+      config.CFOParameters = model.Parameters();
+      config.fUseCEConditionalSampling = (mode == 1);
+
+      RandomGenerators::SetSeed(1);
+      SphericalBlastWaveEventGenerator generator(&parts, config, 0.100, 0.5);
+
+      generator.fCEAccepted = generator.fCETotal = 0;
+      double sumXi = 0., sumXi2 = 0., sumOmega = 0., sumOmega2 = 0.;
+      clock_t start = clock();
+      for (int iev = 0; iev < nevents; ++iev) {
+        vector<int> totals = generator.SampleYields().first;
+        double nXi = totals[idXi], nOmega = totals[idOmega];
+        sumXi += nXi;
+        sumXi2 += nXi * nXi;
+        sumOmega += nOmega;
+        sumOmega2 += nOmega * nOmega;
+      }
+      double time = (clock() - start) / (double)CLOCKS_PER_SEC;
+
+      double meanXi = sumXi / nevents, meanOmega = sumOmega / nevents;
+      double varXi = sumXi2 / nevents - meanXi * meanXi;
+      double varOmega = sumOmega2 / nevents - meanOmega * meanOmega;
+      printf("R = %3.1lf fm  %-11s  acceptance: %8.5lf  time: %7.3lf us/event  <Xi-> = %.5lf +- %.5lf  var(Xi-) = %.5lf  <Omega> = %.6lf +- %.6lf  var(Omega) = %.6lf\n",
+        Radii[iR], mode ? "conditional" : "rejection",
+        generator.fCEAccepted / (double)generator.fCETotal, 1.e6 * time / nevents,
+        meanXi, sqrt(varXi / nevents), varXi, meanOmega, sqrt(varOmega / nevents), varOmega);
+    }
+  }
+
+  // Strangeness-canonical ensemble, Vc = 4/3 pi 3^3 fm^3
+  double Vc = 4. / 3. * xMath::Pi() * 27.;
+  double Ratios[] = { 0.3, 1., 1.5, 7.4 };
+  for (int iR = 0; iR < 4; ++iR) {
+    model.SetVolume(Ratios[iR] * Vc);
+    model.SetCanonicalVolume(Vc);
+
+    for (int mode = 0; mode < 2; ++mode) {
+      EventGeneratorConfiguration config;
+      config.fEnsemble = EventGeneratorConfiguration::SCE;
+      config.fModelType = EventGeneratorConfiguration::PointParticle;
+      config.CFOParameters = model.Parameters();
+      config.fUseCEConditionalSampling = (mode == 1);
+
+      RandomGenerators::SetSeed(1);
+      SphericalBlastWaveEventGenerator generator(&parts, config, 0.100, 0.5);
+
+      double sumXi = 0., sumXi2 = 0., sumOmega = 0., sumOmega2 = 0.;
+      clock_t start = clock();
+      for (int iev = 0; iev < nevents; ++iev) {
+        vector<int> totals = generator.SampleYields().first;
+        double nXi = totals[idXi], nOmega = totals[idOmega];
+        sumXi += nXi;
+        sumXi2 += nXi * nXi;
+        sumOmega += nOmega;
+        sumOmega2 += nOmega * nOmega;
+      }
+      double time = (clock() - start) / (double)CLOCKS_PER_SEC;
+
+      double meanXi = sumXi / nevents, meanOmega = sumOmega / nevents;
+      double varXi = sumXi2 / nevents - meanXi * meanXi;
+      double varOmega = sumOmega2 / nevents - meanOmega * meanOmega;
+      printf("SCE V/Vc = %3.1lf  %-11s  time: %7.3lf us/event  <Xi-> = %.5lf +- %.5lf  var(Xi-) = %.5lf  <Omega> = %.6lf +- %.6lf  var(Omega) = %.6lf\n",
+        Ratios[iR], mode ? "conditional" : "rejection", 1.e6 * time / nevents,
+        meanXi, sqrt(varXi / nevents), varXi, meanOmega, sqrt(varOmega / nevents), varOmega);
+    }
+  }
+
+  return 0;
+}
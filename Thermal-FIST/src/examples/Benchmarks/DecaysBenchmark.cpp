@@ -0,0 +1,83 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include <iostream>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+
+#include "HRGBase.h"
+#include "HRGEventGenerator.h"
+
+#include "ThermalFISTConfig.h"
+
+using namespace std;
+
+#ifdef ThermalFIST_USENAMESPACE
+using namespace thermalfist;
+#endif
+
+// Measures the time spent in the resonance decays for primordial blast-wave events,
+// as well as the time per decay for the 2-, 3-, 4-, and 5-body decays of a single mother particle
+// Usage: DecaysBenchmark <nevents>
+int main(int argc, char *argv[])
+{
+  int nevents = 2000;
+  if (argc > 1)
+    nevents = atoi(argv[1]);
+
+  ThermalParticleSystem parts(ThermalFIST_DEFAULT_LIST_FILE);
+  ThermalModelIdeal model(&parts);
+  model.SetTemperature(0.155);
+  model.SetBaryonChemicalPotential(0.);
+  model.SetElectricChemicalPotential(0.);
+  model.SetStrangenessChemicalPotential(0.);
+  model.SetVolumeRadius(8.);
+
+  EventGeneratorConfiguration config;
+  config.fEnsemble = EventGeneratorConfiguration::GCE;
+  config.fModelType = EventGeneratorConfiguration::PointParticle;
+  config.CFOParameters = model.Parameters();
+
+  RandomGenerators::SetSeed(1);
+  SphericalBlastWaveEventGenerator generator(&parts, config, 0.100, 0.5);
+  vector<SimpleEvent> events(nevents);
+  long long nprimordial = 0;
+  for (int i = 0; i < nevents; ++i) {
+    events[i] = generator.GetEvent(false);
+    nprimordial += events[i].Particles.size();
+  }
+
+  long long nfinal = 0;
+  clock_t start = clock();
+  for (int i = 0; i < nevents; ++i) {
+    SimpleEvent evt = EventGeneratorBase::PerformDecays(events[i], &parts);
+    nfinal += evt.Particles.size();
+  }
+  double time = (clock() - start) / (double)CLOCKS_PER_SEC;
+  printf("Decays: %8.1lf primordial -> %8.1lf final particles per event, %8.3lf ms/event\n",
+    nprimordial / (double)nevents, nfinal / (double)nevents, 1.e3 * time / nevents);
+
+  // N-body decays of a moving particle with mass 1.5 GeV into pions
+  SimpleParticle mother(0.3, -0.2, 1.1, 1.5, 9000111, 0);
+  vector<SimpleParticle> decayProducts;
+  for (int n = 2; n <= 5; ++n) {
+    vector<double> masses(n, 0.13957);
+    vector<long long> pdgs(n, 211);
+    int ndecays = 200000;
+    double pzsum = 0.;
+    start = clock();
+    for (int i = 0; i < ndecays; ++i) {
+      ParticleDecaysMC::ManyBodyDecay(mother, masses, pdgs, decayProducts);
+      pzsum += decayProducts[0].pz;
+    }
+    time = (clock() - start) / (double)CLOCKS_PER_SEC;
+    printf("%d-body decay: %8.3lf us/decay  <pz> of first daughter: %8.5lf\n", n, 1.e6 * time / ndecays, pzsum / ndecays);
+  }
+
+  return 0;
+}
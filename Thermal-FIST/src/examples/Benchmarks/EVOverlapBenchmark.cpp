@@ -0,0 +1,137 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include <iostream>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+
+#include "HRGBase.h"
+#include "HRGEventGenerator.h"
+
+#include "ThermalFISTConfig.h"
+
+using namespace std;
+
+#ifdef ThermalFIST_USENAMESPACE
+using namespace thermalfist;
+#endif
+
+// Excluded-volume rejection in the coordinate space in the single-particle rejection (SPR) mode:
+// each candidate is accepted if it does not overlap with any of the previously accepted particles.
+// Returns the number of accepted particles.
+int AcceptBruteForce(const vector<SimpleParticle>& cands, const vector<int>& ids, const EVRadiiTable& radii, vector<bool>& accepted)
+{
+  vector<int> acc;
+  accepted.assign(cands.size(), false);
+  for (size_t i = 0; i < cands.size(); ++i) {
+    bool overlap = false;
+    for (size_t j = 0; j < acc.size() && !overlap; ++j) {
+      double r = radii.Radius(ids[acc[j]], ids[i]);
+      if (r != 0.0)
+        overlap = (ParticleDecaysMC::ParticleDistanceSquared(cands[acc[j]], cands[i]) <= 4. * r * r);
+    }
+    if (!overlap) {
+      acc.push_back(i);
+      accepted[i] = true;
+    }
+  }
+  return acc.size();
+}
+
+int AcceptWithIndex(const vector<SimpleParticle>& cands, const vector<int>& ids, const EVRadiiTable& radii, vector<bool>& accepted)
+{
+  EVOverlapIndex index(&radii);
+  index.Clear(cands.size());
+  int ret = 0;
+  accepted.assign(cands.size(), false);
+  for (size_t i = 0; i < cands.size(); ++i) {
+    if (!index.CheckOverlap(cands[i], ids[i])) {
+      index.Insert(cands[i], ids[i]);
+      accepted[i] = true;
+      ret++;
+    }
+  }
+  return ret;
+}
+
+// Compares the brute force and the cell list excluded-volume overlap checks
+// for primordial blast-wave events with 10^3-10^4 hadrons
+// Usage: EVOverlapBenchmark <radius in fm> <0 - baryons only, 1 - all hadrons>
+int main(int argc, char *argv[])
+{
+  double radius = 0.3;
+  if (argc > 1)
+    radius = atof(argv[1]);
+
+  bool allHadrons = false;
+  if (argc > 2)
+    allHadrons = atoi(argv[2]);
+
+  ThermalParticleSystem parts(ThermalFIST_DEFAULT_LIST_FILE);
+  ThermalModelIdeal model(&parts);
+  model.SetTemperature(0.155);
+  model.SetBaryonChemicalPotential(0.);
+  model.SetElectricChemicalPotential(0.);
+  model.SetStrangenessChemicalPotential(0.);
+
+  // EV interactions between baryons only, as in the EV-HRG, or between all hadrons
+  int Nspecies = parts.ComponentsNumber();
+  vector< vector<double> > radiiMatrix(Nspecies, vector<double>(Nspecies, 0.));
+  for (int i = 0; i < Nspecies; ++i)
+    for (int j = 0; j < Nspecies; ++j)
+      if (allHadrons || (parts.Particle(i).BaryonCharge() != 0 && parts.Particle(j).BaryonCharge() != 0))
+        radiiMatrix[i][j] = radius;
+  EVRadiiTable radii(radiiMatrix);
+  cout << "Radii table: " << Nspecies << " species, " << radii.NumberOfClasses() << " classes" << endl;
+
+  double Radii[] = { 8., 12., 16., 20. };
+  for (int iR = 0; iR < 4; ++iR) {
+    model.SetVolumeRadius(Radii[iR]);
+
+    EventGeneratorConfiguration config;
+    config.fEnsemble = EventGeneratorConfiguration::GCE;
+    config.fModelType = EventGeneratorConfiguration::PointParticle;
+    config.CFOParameters = model.Parameters();
+
+    RandomGenerators::SetSeed(1);
+    SphericalBlastWaveEventGenerator generator(&parts, config, 0.100, 0.5);
+
+    int nevents = 5;
+    double timeBrute = 0., timeIndex = 0.;
+    long long nparticles = 0, nbaryons = 0, naccepted = 0;
+    bool identical = true;
+    for (int iev = 0; iev < nevents; ++iev) {
+      SimpleEvent evt = generator.GetEvent(false);
+      vector<int> ids(evt.Particles.size());
+      for (size_t i = 0; i < evt.Particles.size(); ++i) {
+        ids[i] = parts.PdgToId(evt.Particles[i].PDGID);
+        if (radii.MaxRadius(ids[i]) > 0.)
+          nbaryons++;
+      }
+      nparticles += evt.Particles.size();
+
+      vector<bool> accBrute, accIndex;
+      clock_t start = clock();
+      int nacc = AcceptBruteForce(evt.Particles, ids, radii, accBrute);
+      timeBrute += (clock() - start) / (double)CLOCKS_PER_SEC;
+
+      start = clock();
+      AcceptWithIndex(evt.Particles, ids, radii, accIndex);
+      timeIndex += (clock() - start) / (double)CLOCKS_PER_SEC;
+
+      naccepted += nacc;
+      identical &= (accBrute == accIndex);
+    }
+
+    printf("R = %4.1lf fm: %7.0lf particles (%6.0lf with EV) per event, %6.0lf accepted  brute force: %8.4lf s/event  cell list: %8.4lf s/event  (x%.1lf)  %s\n",
+      Radii[iR], nparticles / (double)nevents, nbaryons / (double)nevents, naccepted / (double)nevents,
+      timeBrute / nevents, timeIndex / nevents, timeBrute / timeIndex, identical ? "identical" : "MISMATCH");
+  }
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include <iostream>
+#include <fstream>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+
+#include "HRGBase.h"
+#include "HRGEventGenerator.h"
+
+#include "ThermalFISTConfig.h"
+
+using namespace std;
+
+#ifdef ThermalFIST_USENAMESPACE
+using namespace thermalfist;
+#endif
+
+long long FileSize(const string& filename)
+{
+  ifstream fin(filename, ios::binary | ios::ate);
+  return fin.is_open() ? static_cast<long long>(fin.tellg()) : 0;
+}
+
+// Writes the same set of events with the ascii and the binary event writers
+// and compares the write/read times and the file sizes
+// Usage: EventOutputBenchmark <nevents>
+int main(int argc, char *argv[])
+{
+  int nevents = 20000;
+  if (argc > 1)
+    nevents = atoi(argv[1]);
+
+  ThermalParticleSystem parts(ThermalFIST_DEFAULT_LIST_FILE);
+  ThermalModelIdeal model(&parts);
+  model.SetTemperature(0.155);
+  model.SetBaryonChemicalPotential(0.);
+  model.SetElectricChemicalPotential(0.);
+  model.SetStrangenessChemicalPotential(0.);
+  model.SetVolumeRadius(6.);
+
+  EventGeneratorConfiguration config;
+  config.fEnsemble = EventGeneratorConfiguration::GCE;
+  config.fModelType = EventGeneratorConfiguration::PointParticle;
+  config.CFOParameters = model.Parameters();
+
+  RandomGenerators::SetSeed(1);
+  SphericalBlastWaveEventGenerator generator(&parts, config, 0.100, 0.5);
+  vector<SimpleEvent> events(nevents);
+  long long nparticles = 0;
+  for (int i = 0; i < nevents; ++i) {
+    events[i] = generator.GetEvent();
+    nparticles += events[i].Particles.size();
+  }
+  cout << "Generated " << nevents << " events with " << nparticles / (double)nevents << " particles per event on average" << endl;
+
+  SimpleEvent::EventOutputConfig outconfig;
+  outconfig.printCoordinates = true;
+  outconfig.printMotherPdg = true;
+  outconfig.printDecayEpoch = true;
+
+  // Ascii reference
+  {
+    string filename = "EventOutputBenchmark.dat";
+    clock_t start = clock();
+    {
+      EventWriterAsciiExtended writer(filename, outconfig);
+      for (int i = 0; i < nevents; ++i)
+        writer.WriteEvent(events[i]);
+    }
+    double time = (clock() - start) / (double)CLOCKS_PER_SEC;
+    printf("%-30s write: %8.3lf s  size: %8.2lf MB\n", "ascii (extended)", time, FileSize(filename) / 1048576.);
+    remove(filename.c_str());
+  }
+
+  for (int mode = 0; mode < 4; ++mode) {
+    bool singlePrecision = (mode >= 1);
+    int compressionLevel = (mode == 2) ? 1 : ((mode == 3) ? 6 : 0);
+    if (compressionLevel > 0 && !BinaryEventFormat::CompressionAvailable())
+      continue;
+
+    string filename = "EventOutputBenchmark.bin";
+    clock_t start = clock();
+    {
+      BinaryEventWriter writer(filename, outconfig, singlePrecision, compressionLevel);
+      for (int i = 0; i < nevents; ++i)
+        writer.WriteEvent(events[i]);
+    }
+    double timeWrite = (clock() - start) / (double)CLOCKS_PER_SEC;
+
+    start = clock();
+    BinaryEventReader reader(filename);
+    SimpleEvent evt;
+    long long nread = 0;
+    double sumpz = 0., sumpzref = 0.;
+    int ev = 0;
+    while (reader.ReadEvent(evt)) {
+      nread += evt.Particles.size();
+      for (size_t ip = 0; ip < evt.Particles.size(); ++ip) {
+        sumpz += evt.Particles[ip].pz * evt.Particles[ip].pz;
+        sumpzref += events[ev].Particles[ip].pz * events[ev].Particles[ip].pz;
+      }
+      ++ev;
+    }
+    double timeRead = (clock() - start) / (double)CLOCKS_PER_SEC;
+
+    char name[100];
+    sprintf(name, "binary (%s, zlib level %d)", singlePrecision ? "float" : "double", compressionLevel);
+    printf("%-30s write: %8.3lf s  size: %8.2lf MB  read: %8.3lf s  particles read: %lld/%lld  <pz^2> ratio: %.8lf\n",
+      name, timeWrite, FileSize(filename) / 1048576., timeRead, nread, nparticles, sumpz / sumpzref);
+    remove(filename.c_str());
+  }
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include <iostream>
+#include <iomanip>
+#include <ctime>
+#include <cstdio>
+#include <cmath>
+
+#include "HRGBase.h"
+#include "HRGEventGenerator.h"
+#include "HRGEventGenerator/HypersurfaceSampler.h"
+
+#include "ThermalFISTConfig.h"
+
+using namespace std;
+
+#ifdef ThermalFIST_USENAMESPACE
+using namespace thermalfist;
+#endif
+
+// Synthetic boost-invariant hypersurface: constant proper time tau,
+// a transverse disk of radius R with a linear transverse flow profile,
+// and the space-time rapidity range [-etamax, etamax]
+// If Tvar > 0, the temperature varies across the elements by up to Tvar
+ParticlizationHypersurface SyntheticHypersurface(double tau = 10., double R = 10., double betas = 0.6, double etamax = 2.0,
+  double T = 0.150, double Tvar = 0.)
+{
+  ParticlizationHypersurface ret;
+  double dx = 0.5, deta = 0.1;
+  for (double eta = -etamax + 0.5 * deta; eta < etamax; eta += deta) {
+    for (double x = -R + 0.5 * dx; x < R; x += dx) {
+      for (double y = -R + 0.5 * dx; y < R; y += dx) {
+        double r = sqrt(x * x + y * y);
+        if (r > R)
+          continue;
+
+        ParticlizationHypersurfaceElement elem;
+        elem.tau = tau;
+        elem.x = x;
+        elem.y = y;
+        elem.eta = eta;
+
+        // Flow: transverse velocity betas * r / R, Bjorken longitudinally
+        double vT = betas * r / R;
+        double uT = vT / sqrt(1. - vT * vT);
+        double gT = sqrt(1. + uT * uT);
+        double phi = atan2(y, x);
+        elem.u[0] = gT * cosh(eta);
+        elem.u[1] = uT * cos(phi);
+        elem.u[2] = uT * sin(phi);
+        elem.u[3] = gT * sinh(eta);
+
+        // Covariant normal vector of the tau = const surface
+        double vol = tau * dx * dx * deta;
+        elem.dsigma[0] = vol * cosh(eta);
+        elem.dsigma[1] = 0.;
+        elem.dsigma[2] = 0.;
+        elem.dsigma[3] = -vol * sinh(eta);
+
+        elem.T = T + Tvar * (r / R - 0.5);
+        elem.muB = elem.muQ = elem.muS = 0.;
+        elem.edens = elem.rhoB = 0.;
+
+        ret.push_back(elem);
+      }
+    }
+  }
+  return ret;
+}
+
+// Compares the particles-per-second rate of the scalar and batched
+// momentum sampling from a hypersurface
+// Usage: HypersurfaceSamplingBenchmark <nparticles> <batchsize>
+int main(int argc, char *argv[])
+{
+  int nparticles = 2000000;
+  if (argc > 1)
+    nparticles = atoi(argv[1]);
+
+  int batchsize = 256;
+  if (argc > 2)
+    batchsize = atoi(argv[2]);
+
+  vector<ThermalParticle> particles;
+  particles.push_back(ThermalParticle(true, "pi+", 211, 1., -1, 0.138, 0, 0, 1));
+  particles.push_back(ThermalParticle(true, "p", 2212, 2., 1, 0.938, 0, 1, 1));
+
+  for (int isurf = 0; isurf < 2; ++isurf) {
+    double Tvar = (isurf == 0) ? 0. : 0.020;
+    ParticlizationHypersurface hypersurface = SyntheticHypersurface(10., 10., 0.6, 2.0, 0.150, Tvar);
+    RandomGenerators::VolumeElementSampler sampler(&hypersurface);
+
+    cout << "Hypersurface with " << hypersurface.size() << " elements, ";
+    if (Tvar == 0.)
+      cout << "uniform temperature" << endl;
+    else
+      cout << "temperature varying by " << Tvar << " GeV" << endl;
+
+    for (size_t ipart = 0; ipart < particles.size(); ++ipart) {
+      const ThermalParticle& particle = particles[ipart];
+
+      RandomGenerators::SetSeed(1);
+      double meanpT = 0.;
+      clock_t start = clock();
+      for (int i = 0; i < nparticles; ++i) {
+        int ielem = sampler.SampleVolumeElement();
+        vector<double> coords = RandomGenerators::HypersurfaceMomentumGenerator::SamplePhaseSpaceCoordinateFromElement(
+          &hypersurface[ielem], &particle, particle.Mass());
+        meanpT += sqrt(coords[0] * coords[0] + coords[1] * coords[1]);
+      }
+      double timeScalar = (clock() - start) / (double)CLOCKS_PER_SEC;
+      meanpT /= nparticles;
+
+      RandomGenerators::SetSeed(1);
+      RandomGenerators::HypersurfaceMomentumGenerator generator(&hypersurface, &particle, &sampler, 0., batchsize);
+      double meanpTbatch = 0.;
+      start = clock();
+      for (int i = 0; i < nparticles; ++i) {
+        vector<double> coords = generator.GetMomentum();
+        meanpTbatch += sqrt(coords[0] * coords[0] + coords[1] * coords[1]);
+      }
+      double timeBatch = (clock() - start) / (double)CLOCKS_PER_SEC;
+      meanpTbatch /= nparticles;
+
+      printf("%-5s scalar:  %12.0lf particles/s  <pT> = %.4lf GeV\n", particle.Name().c_str(), nparticles / timeScalar, meanpT);
+      printf("%-5s batched: %12.0lf particles/s  <pT> = %.4lf GeV  (x%.2lf)\n", particle.Name().c_str(), nparticles / timeBatch, meanpTbatch, timeScalar / timeBatch);
+    }
+    cout << endl;
+  }
+
+  return 0;
+}
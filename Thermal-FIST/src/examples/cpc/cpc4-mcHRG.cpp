@@ -282,10 +282,6 @@ int main(int argc, char *argv[])
     model->SetElectricChemicalPotential(muQs[ind]);
     model->SetStrangenessChemicalPotential(muSs[ind]);
 
-    double mc_B = 0., mc_Q = 0., mc_S = 0., mc_p = 0., mc_k = 0.;
-    double mc_B2 = 0., mc_Q2 = 0., mc_S2 = 0., mc_BQ = 0., mc_QS = 0., mc_BS = 0.;
-    double mc_p2 = 0., mc_k2 = 0., mc_pk = 0., mc_pQ = 0., mc_Qk = 0.;
-
     // Setup the configuration for event generator
     EventGeneratorConfiguration config;
     config.fEnsemble = EventGeneratorConfiguration::GCE;
@@ -293,70 +289,34 @@ int main(int argc, char *argv[])
     config.CFOParameters = model->Parameters();
 
     SphericalBlastWaveEventGenerator generator(model->TPS(), config, 0.100, 0.5);
-    double wsum = 0.;
-    for (int i = 0; i < nevents; ++i) {
-      SimpleEvent ev = generator.GetEvent();
-      int mcev_B = 0, mcev_Q = 0, mcev_S = 0, mcev_p = 0, mcev_k = 0;
-
-      for (size_t part = 0; part < ev.Particles.size(); ++part) {
-        long long pdgid = ev.Particles[part].PDGID;
-        const ThermalParticle &thermpart = parts.ParticleByPDG(pdgid);
-        mcev_B += thermpart.BaryonCharge();
-        mcev_Q += thermpart.ElectricCharge();
-        mcev_S += thermpart.Strangeness();
-
-        if (pdgid == 2212)
-          mcev_p += 1;
-        else if (pdgid == -2212)
-          mcev_p += (-1);
-
-        if (pdgid == 321)
-          mcev_k += 1;
-        else if (pdgid == -321)
-          mcev_k += (-1);
-      }
 
-      mc_B += ev.weight * mcev_B;
-      mc_Q += ev.weight * mcev_Q;
-      mc_S += ev.weight * mcev_S;
-      mc_p += ev.weight * mcev_p;
-      mc_k += ev.weight * mcev_k;
-
-      mc_B2 += ev.weight * mcev_B * mcev_B;
-      mc_Q2 += ev.weight * mcev_Q * mcev_Q;
-      mc_S2 += ev.weight * mcev_S * mcev_S;
-      mc_p2 += ev.weight * mcev_p * mcev_p;
-      mc_k2 += ev.weight * mcev_k * mcev_k;
-
-      mc_BQ += ev.weight * mcev_B * mcev_Q;
-      mc_QS += ev.weight * mcev_Q * mcev_S;
-      mc_BS += ev.weight * mcev_B * mcev_S;
-      mc_pQ += ev.weight * mcev_p * mcev_Q;
-      mc_pk += ev.weight * mcev_p * mcev_k;
-      mc_Qk += ev.weight * mcev_Q * mcev_k;
-
-      wsum += ev.weight;
+    // Event-by-event B, Q, S, net-proton, and net-kaon numbers
+    vector<EventObservable> observables;
+    observables.push_back(EventObservable(&parts, ConservedCharge::BaryonCharge));
+    observables.push_back(EventObservable(&parts, ConservedCharge::ElectricCharge));
+    observables.push_back(EventObservable(&parts, ConservedCharge::StrangenessCharge));
+    observables.push_back(EventObservable::NetParticleNumber(2212));
+    observables.push_back(EventObservable::NetParticleNumber(321));
+    enum { iB = 0, iQ, iS, ip, ik };
+
+    EventCumulantAccumulator cumulants(observables, 2);
+    for (int i = 0; i < nevents; ++i) {
+      cumulants.AddEvent(generator.GetEvent());
     }
 
-    double chi1B = mc_B / wsum;
-    double chi1Q = mc_Q / wsum;
-    double chi1S = mc_S / wsum;
-
-    double chi1p = mc_p / wsum;
-    double chi1k = mc_k / wsum;
-
-    double chi2B = mc_B2 / wsum - mc_B / wsum * mc_B / wsum;
-    double chi2Q = mc_Q2 / wsum - mc_Q / wsum * mc_Q / wsum;
-    double chi2S = mc_S2 / wsum - mc_S / wsum * mc_S / wsum;
-    double chi11BS = mc_BS / wsum - mc_B / wsum * mc_S / wsum;
-    double chi11QS = mc_QS / wsum - mc_Q / wsum * mc_S / wsum;
-    double chi11BQ = mc_BQ / wsum - mc_B / wsum * mc_Q / wsum;
-
-    double chi2p = mc_p2 / wsum - mc_p / wsum * mc_p / wsum;
-    double chi2k = mc_k2 / wsum - mc_k / wsum * mc_k / wsum;
-    double chi11pk = mc_pk / wsum - mc_p / wsum * mc_k / wsum;
-    double chi11Qk = mc_Qk / wsum - mc_Q / wsum * mc_k / wsum;
-    double chi11pQ = mc_pQ / wsum - mc_p / wsum * mc_Q / wsum;
+    double chi1k = cumulants.Mean(ik);
+
+    double chi2B = cumulants.Cumulant(iB, 2);
+    double chi2S = cumulants.Cumulant(iS, 2);
+    double chi11BS = cumulants.Cumulant({ iB, iS });
+    double chi11QS = cumulants.Cumulant({ iQ, iS });
+    double chi11BQ = cumulants.Cumulant({ iB, iQ });
+
+    double chi2p = cumulants.Cumulant(ip, 2);
+    double chi2k = cumulants.Cumulant(ik, 2);
+    double chi11pk = cumulants.Cumulant({ ip, ik });
+    double chi11Qk = cumulants.Cumulant({ iQ, ik });
+    double chi11pQ = cumulants.Cumulant({ ip, iQ });
 
     printf("%15lf%15lf%15lf%15lf%15lf%15lf%15lf\n", ens[ind], chi11BS / chi2S, chi11QS / chi2S, chi11BQ / chi2B, chi11pk / chi2k, chi11Qk / chi2k, chi11pQ / chi2p);
   
@@ -11,6 +11,7 @@
 #include <algorithm>
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
 #include "HRGBase/Utility.h"
 #include "HRGBase/ThermalParticleSystem.h"
@@ -81,6 +82,8 @@ namespace thermalfist {
     //SetCalculationType(IdealGasFunctions::Quadratures);
     SetUseWidth(TPS()->ResonanceWidthIntegrationType());
 
+    m_ThermalBranchingRatiosRevision = -1;
+
     ResetCalculatedFlags();
 
     m_ValidityLog = "";
@@ -317,6 +320,7 @@ namespace thermalfist {
 
   void ThermalModelBase::ChangeTPS(ThermalParticleSystem *TPS_) {
     m_TPS = TPS_;
+    m_ThermalBranchingRatiosRevision = -1;
     m_Chem.resize(m_TPS->Particles().size());
     m_densities.resize(m_TPS->Particles().size());
     m_densitiestotal.resize(m_TPS->Particles().size());
@@ -405,38 +409,36 @@ namespace thermalfist {
 
   void ThermalModelBase::CalculateFeeddown() {
     if (m_UseWidth && m_TPS->ResonanceWidthIntegrationType() == ThermalParticle::eBW) {
-      for (int i = 0; i < m_TPS->ComponentsNumber(); ++i) {
-        m_TPS->Particle(i).CalculateThermalBranchingRatios(m_Parameters, m_UseWidth, m_Chem[i] + MuShift(i));
+      // The thermal branching ratios only depend on T and mu
+      std::vector<double> BRparameters;
+      BRparameters.reserve(4 + m_TPS->ComponentsNumber());
+      BRparameters.push_back(m_Parameters.T);
+      BRparameters.push_back(m_Parameters.gammaq);
+      BRparameters.push_back(m_Parameters.gammaS);
+      BRparameters.push_back(m_Parameters.gammaC);
+      for (int i = 0; i < m_TPS->ComponentsNumber(); ++i)
+        BRparameters.push_back(m_Chem[i] + MuShift(i));
+
+      if (BRparameters != m_ThermalBranchingRatiosParameters || m_TPS->DecaysRevision() != m_ThermalBranchingRatiosRevision) {
+        for (int i = 0; i < m_TPS->ComponentsNumber(); ++i) {
+          m_TPS->Particle(i).CalculateThermalBranchingRatios(m_Parameters, m_UseWidth, BRparameters[4 + i]);
+        }
+        m_TPS->ProcessDecays();
+        m_ThermalBranchingRatiosParameters = BRparameters;
+        m_ThermalBranchingRatiosRevision = m_TPS->DecaysRevision();
       }
-      m_TPS->ProcessDecays();
     }
 
     // Primordial
     m_densitiesbyfeeddown[static_cast<int>(Feeddown::Primordial)] = m_densities;
 
     // According to stability flags
-    int feed_index = static_cast<int>(Feeddown::StabilityFlag);
-    for (int i = 0; i < m_TPS->ComponentsNumber(); ++i) {
-      m_densitiestotal[i] = m_densities[i];
-      //const std::vector< std::pair<double, int> >& decayContributions = m_TPS->Particles()[i].DecayContributionsByFeeddown()[feed_index];
-      const ThermalParticleSystem::DecayContributionsToParticle& decayContributions = m_TPS->DecayContributionsByFeeddown()[feed_index][i];
-      for (size_t j = 0; j < decayContributions.size(); ++j)
-        if (i != decayContributions[j].second) 
-          m_densitiestotal[i] += decayContributions[j].first * m_densities[decayContributions[j].second];
-    }
-
-    m_densitiesbyfeeddown[feed_index] = m_densitiestotal;
+    m_densitiestotal = m_TPS->ApplyFeeddown(m_densities, Feeddown::StabilityFlag);
+    m_densitiesbyfeeddown[static_cast<int>(Feeddown::StabilityFlag)] = m_densitiestotal;
 
     // Weak, EM, strong
-    for (feed_index = static_cast<int>(Feeddown::Weak); feed_index <= static_cast<int>(Feeddown::Strong); ++feed_index) {
-      for (int i = 0; i < m_TPS->ComponentsNumber(); ++i) {
-        m_densitiesbyfeeddown[feed_index][i] = m_densities[i];
-        //const std::vector< std::pair<double, int> >& decayContributions = m_TPS->Particles()[i].DecayContributionsByFeeddown()[feed_index];
-        const ThermalParticleSystem::DecayContributionsToParticle& decayContributions = m_TPS->DecayContributionsByFeeddown()[feed_index][i];
-        for (size_t j = 0; j < decayContributions.size(); ++j)
-          if (i != decayContributions[j].second)
-            m_densitiesbyfeeddown[feed_index][i] += decayContributions[j].first * m_densities[decayContributions[j].second];
-      }
+    for (int feed_index = static_cast<int>(Feeddown::Weak); feed_index <= static_cast<int>(Feeddown::Strong); ++feed_index) {
+      m_densitiesbyfeeddown[feed_index] = m_TPS->ApplyFeeddown(m_densities, static_cast<Feeddown::Type>(feed_index));
     }
 
     m_FeeddownCalculated = true;
@@ -918,90 +920,64 @@ namespace thermalfist {
   void ThermalModelBase::CalculateTwoParticleFluctuationsDecays()
   {
     // Decay contributions here are done according to Eq. (47) in nucl-th/0606036
+    // The average decay contributions are evaluated as A * C_prim * A^T,
+    // where A = 1 + D is the sparse matrix of the mean decay feeddown
+    // and C_prim the matrix of primordial correlations
   
     int NN = m_densities.size();
 
-    // Fluctuations for all
+    MatrixXd primCorrel(NN, NN);
     for (int i = 0; i < NN; ++i)
-      //for(int j=0;j<NN;++j) 
-    {
-      m_TotalCorrel[i][i] = m_PrimCorrel[i][i];
-      //for (int r = 0; r < m_TPS->Particles()[i].DecayContributions().size(); ++r) {
-      const ThermalParticleSystem::DecayContributionsToParticle& decayContributions = m_TPS->DecayContributionsByFeeddown()[Feeddown::StabilityFlag][i];
-      for (size_t r = 0; r < decayContributions.size(); ++r) {
-        int rr = decayContributions[r].second;
-      
-        m_TotalCorrel[i][i] += 2. * m_PrimCorrel[i][rr] * decayContributions[r].first;
-      
-        for (size_t r2 = 0; r2 < decayContributions.size(); ++r2) {
-          int rr2 = decayContributions[r2].second;
-          m_TotalCorrel[i][i] += m_PrimCorrel[rr][rr2] * decayContributions[r].first * decayContributions[r2].first;
-        }
+      for (int j = 0; j < NN; ++j)
+        primCorrel(i, j) = m_PrimCorrel[i][j];
 
-        // Probabilistic decays
-        m_TotalCorrel[i][i] += m_densities[rr] / m_Parameters.T * m_TPS->DecayCumulants()[i][r].first[1];
-        //m_TotalCorrel[i][i] += m_densities[rr] / m_Parameters.T * m_TPS->Particles()[i].DecayCumulants()[r].first[1];
-        //if (rr != i) { // && !m_TPS->Particles()[r].IsStable()) {
-        //  double nij = 0., ni = 0., nj = 0., dnij = 0.;
-        //  const auto& decayDistributions = TPS()->ResonanceFinalStatesDistributions()[rr];
-        //  for (size_t br = 0; br < decayDistributions.size(); ++br) {
-        //    nij += decayDistributions[br].first * decayDistributions[br].second[i] * decayDistributions[br].second[i];
-        //    ni += decayDistributions[br].first * decayDistributions[br].second[i];
-        //    nj += decayDistributions[br].first * decayDistributions[br].second[i];
-        //  }
-        //  dnij = nij - ni * nj;
-        //  m_TotalCorrel[i][i] += m_densities[rr] / Parameters().T * dnij;
-        //}
-      }
+    std::vector< Triplet<double> > decayElements;
+    for (int i = 0; i < NN; ++i) {
+      decayElements.push_back(Triplet<double>(i, i, 1.));
+      const ThermalParticleSystem::DecayContributionsToParticle& decayContributions = m_TPS->DecayContributionsByFeeddown()[Feeddown::StabilityFlag][i];
+      for (size_t r = 0; r < decayContributions.size(); ++r)
+        decayElements.push_back(Triplet<double>(i, decayContributions[r].second, decayContributions[r].first));
     }
+    SparseMatrix<double, RowMajor> decayMatrix(NN, NN);
+    decayMatrix.setFromTriplets(decayElements.begin(), decayElements.end());
 
+    MatrixXd totalCorrel = decayMatrix * primCorrel;
+    totalCorrel = (totalCorrel * decayMatrix.transpose()).eval();
 
-    // Correlations only for stable
+    // Fluctuations for all
     for (int i = 0; i < NN; ++i) {
-      if (m_TPS->Particles()[i].IsStable()) {
-        for (int j = 0; j < NN; ++j) {
-          if (j != i && m_TPS->Particles()[j].IsStable()) {
-            m_TotalCorrel[i][j] = m_PrimCorrel[i][j];
-
-            const ThermalParticleSystem::DecayContributionsToParticle& decayContributionsI = m_TPS->DecayContributionsByFeeddown()[Feeddown::StabilityFlag][i];
-            const ThermalParticleSystem::DecayContributionsToParticle& decayContributionsJ = m_TPS->DecayContributionsByFeeddown()[Feeddown::StabilityFlag][j];
-            
-            for (size_t r = 0; r < decayContributionsJ.size(); ++r) {
-              int rr = decayContributionsJ[r].second;
-              m_TotalCorrel[i][j] += m_PrimCorrel[i][rr] * decayContributionsJ[r].first;
-            }
-
-            for (size_t r = 0; r < decayContributionsI.size(); ++r) {
-              int rr = decayContributionsI[r].second;
-              m_TotalCorrel[i][j] += m_PrimCorrel[j][rr] * decayContributionsI[r].first;
-            }
-
-            for (size_t r = 0; r < decayContributionsI.size(); ++r) {
-              int rr = decayContributionsI[r].second;
+      m_TotalCorrel[i][i] = totalCorrel(i, i);
 
-              for (size_t r2 = 0; r2 < decayContributionsJ.size(); ++r2) {
-                int rr2 = decayContributionsJ[r2].second;
-                m_TotalCorrel[i][j] += m_PrimCorrel[rr][rr2] * decayContributionsI[r].first * decayContributionsJ[r2].first;
-              }
-            }
+      // Probabilistic decays
+      const ThermalParticleSystem::DecayCumulantsContributionsToParticle& decayCumulants = m_TPS->DecayCumulants()[i];
+      for (size_t r = 0; r < decayCumulants.size(); ++r) {
+        int rr = decayCumulants[r].second;
+        m_TotalCorrel[i][i] += m_densities[rr] / m_Parameters.T * decayCumulants[r].first[1];
+      }
+    }
 
-            // Contribution from probabilistic decays
-            for (int r = 0; r < m_TPS->ComponentsNumber(); ++r) {
-              if (r != i && r != j) { // && !m_TPS->Particles()[r].IsStable()) {
-                double nij = 0., ni = 0., nj = 0., dnij = 0.;
-                //const ThermalParticle &tpart = m_TPS->Particle(r);
-                const ThermalParticleSystem::ResonanceFinalStatesDistribution &decayDistributions = m_TPS->ResonanceFinalStatesDistributions()[r];
-                for (size_t br = 0; br < decayDistributions.size(); ++br) {
-                  nij += decayDistributions[br].first * decayDistributions[br].second[i] * decayDistributions[br].second[j];
-                  ni  += decayDistributions[br].first * decayDistributions[br].second[i];
-                  nj  += decayDistributions[br].first * decayDistributions[br].second[j];
-                }
-                dnij = nij - ni * nj;
-                m_TotalCorrel[i][j] += m_densities[r] / m_Parameters.T * dnij;
-              }
-            }
-          }
-        }
+    // Correlations only for stable
+    // Contribution from probabilistic decays as a product of the
+    // decay covariances matrix and the vector of resonance densities
+    const std::vector<int>& stableIds = m_TPS->StableParticleIndices();
+    const std::vector<int>& resonanceIds = m_TPS->DecayCovarianceResonances();
+    int Ns = stableIds.size();
+    int Nr = resonanceIds.size();
+    VectorXd probabilisticCorrel = VectorXd::Zero(Ns * Ns);
+    if (Nr > 0) {
+      VectorXd resonanceDensities(Nr);
+      for (int k = 0; k < Nr; ++k)
+        resonanceDensities[k] = m_densities[resonanceIds[k]] / m_Parameters.T;
+      Map<const MatrixXd> decayCovariances(&m_TPS->DecayCovariances()[0], Ns * Ns, Nr);
+      probabilisticCorrel = decayCovariances * resonanceDensities;
+    }
+
+    for (int a = 0; a < Ns; ++a) {
+      int i = stableIds[a];
+      for (int b = 0; b < Ns; ++b) {
+        int j = stableIds[b];
+        if (j != i)
+          m_TotalCorrel[i][j] = totalCorrel(i, j) + probabilisticCorrel[a * Ns + b];
       }
     }
 
@@ -85,6 +85,79 @@ namespace thermalfist {
   {
     FillResonanceDecays(); 
     FillResonanceDecaysByFeeddown();
+
+    // Unique across all the particle lists
+    static int DecaysRevisionCounter = 0;
+    m_DecaysRevision = ++DecaysRevisionCounter;
+  }
+
+  void ThermalParticleSystem::FillFeeddownMatrix(Feeddown::Type feeddown)
+  {
+    int NN = m_Particles.size();
+    if (m_FeeddownMatrices.size() != Feeddown::NumberOfTypes)
+      m_FeeddownMatrices.resize(Feeddown::NumberOfTypes);
+    FeeddownMatrix& matrix = m_FeeddownMatrices[feeddown];
+    matrix.RowOffsets.resize(NN + 1);
+    matrix.Columns.clear();
+    matrix.Values.clear();
+    matrix.RowOffsets[0] = 0;
+    for (int i = 0; i < NN; ++i) {
+      matrix.Columns.push_back(i);
+      matrix.Values.push_back(1.);
+      if (feeddown != Feeddown::Primordial && static_cast<int>(m_DecayContributionsByFeeddown[feeddown].size()) == NN) {
+        const DecayContributionsToParticle& decayContributions = m_DecayContributionsByFeeddown[feeddown][i];
+        for (size_t j = 0; j < decayContributions.size(); ++j) {
+          if (i != decayContributions[j].second) {
+            matrix.Columns.push_back(decayContributions[j].second);
+            matrix.Values.push_back(decayContributions[j].first);
+          }
+        }
+      }
+      matrix.RowOffsets[i + 1] = matrix.Columns.size();
+    }
+  }
+
+  std::vector<double> ThermalParticleSystem::ApplyFeeddown(const std::vector<double>& densities, Feeddown::Type feeddown) const
+  {
+    const FeeddownMatrix& matrix = m_FeeddownMatrices[feeddown];
+    int NN = static_cast<int>(matrix.RowOffsets.size()) - 1;
+    std::vector<double> ret(densities.size(), 0.);
+    for (int i = 0; i < NN; ++i) {
+      double tsum = 0.;
+      for (int k = matrix.RowOffsets[i]; k < matrix.RowOffsets[i + 1]; ++k)
+        tsum += matrix.Values[k] * densities[matrix.Columns[k]];
+      ret[i] = tsum;
+    }
+    return ret;
+  }
+
+  std::vector< std::vector<double> > ThermalParticleSystem::ApplyFeeddown(const std::vector< std::vector<double> >& densities, Feeddown::Type feeddown) const
+  {
+    const FeeddownMatrix& matrix = m_FeeddownMatrices[feeddown];
+    int NN = static_cast<int>(matrix.RowOffsets.size()) - 1;
+    int Nstates = densities.size();
+
+    // Contiguous storage, the states are the fastest index
+    std::vector<double> in(NN * Nstates), out(NN * Nstates, 0.);
+    for (int s = 0; s < Nstates; ++s)
+      for (int i = 0; i < NN; ++i)
+        in[i * Nstates + s] = densities[s][i];
+
+    for (int i = 0; i < NN; ++i) {
+      double* outrow = &out[i * Nstates];
+      for (int k = matrix.RowOffsets[i]; k < matrix.RowOffsets[i + 1]; ++k) {
+        double val = matrix.Values[k];
+        const double* inrow = &in[matrix.Columns[k] * Nstates];
+        for (int s = 0; s < Nstates; ++s)
+          outrow[s] += val * inrow[s];
+      }
+    }
+
+    std::vector< std::vector<double> > ret(Nstates, std::vector<double>(NN));
+    for (int s = 0; s < Nstates; ++s)
+      for (int i = 0; i < NN; ++i)
+        ret[s][i] = out[i * Nstates + s];
+    return ret;
   }
 
   void ThermalParticleSystem::FillDecayProperties()
@@ -223,6 +296,65 @@ namespace thermalfist {
       }
 
     }
+
+    FillDecayCovariances();
+
+    FillFeeddownMatrix(Feeddown::Primordial);
+    FillFeeddownMatrix(Feeddown::StabilityFlag);
+  }
+
+  void ThermalParticleSystem::FillDecayCovariances()
+  {
+    int NN = m_Particles.size();
+
+    m_StableParticleIndices.clear();
+    vector<int> stableIndex(NN, -1);
+    for (int i = 0; i < NN; ++i) {
+      if (m_Particles[i].IsStable()) {
+        stableIndex[i] = m_StableParticleIndices.size();
+        m_StableParticleIndices.push_back(i);
+      }
+    }
+    int Ns = m_StableParticleIndices.size();
+
+    m_DecayCovarianceResonances.clear();
+    m_DecayCovariances.clear();
+    vector<double> cov(Ns * Ns), mean(Ns);
+    vector<int> nonzero;
+    nonzero.reserve(Ns);
+    for (int r = 0; r < NN; ++r) {
+      const ResonanceFinalStatesDistribution& decayDistributions = m_ResonanceFinalStatesDistributions[r];
+      // Deterministic final state, no covariances
+      if (decayDistributions.size() < 2)
+        continue;
+
+      fill(cov.begin(), cov.end(), 0.);
+      fill(mean.begin(), mean.end(), 0.);
+      for (size_t br = 0; br < decayDistributions.size(); ++br) {
+        double prob = decayDistributions[br].first;
+        const vector<int>& numbers = decayDistributions[br].second;
+        nonzero.clear();
+        for (int a = 0; a < Ns; ++a) {
+          if (numbers[m_StableParticleIndices[a]] != 0)
+            nonzero.push_back(a);
+        }
+        for (size_t ia = 0; ia < nonzero.size(); ++ia) {
+          int a = nonzero[ia];
+          double na = prob * numbers[m_StableParticleIndices[a]];
+          mean[a] += na;
+          for (size_t ib = 0; ib < nonzero.size(); ++ib) {
+            int b = nonzero[ib];
+            cov[a * Ns + b] += na * numbers[m_StableParticleIndices[b]];
+          }
+        }
+      }
+      for (int a = 0; a < Ns; ++a)
+        for (int b = 0; b < Ns; ++b)
+          cov[a * Ns + b] -= mean[a] * mean[b];
+
+      m_DecayCovarianceResonances.push_back(r);
+      m_DecayCovariances.insert(m_DecayCovariances.end(), cov.begin(), cov.end());
+    }
   }
 
 
@@ -961,6 +1093,8 @@ namespace thermalfist {
     m_SortMode = ThermalParticleSystem::SortByMass;
 
     m_DecayContributionsByFeeddown.resize(Feeddown::NumberOfTypes);
+    m_FeeddownMatrices.resize(Feeddown::NumberOfTypes);
+    m_DecaysRevision = 0;
 
     SetResonanceWidthShape(ThermalParticle::RelativisticBreitWigner);
     SetResonanceWidthIntegrationType(ThermalParticle::ZeroWidth);
@@ -1596,6 +1730,10 @@ namespace thermalfist {
       if (m_Particles[i].DecayType() != ParticleDecayType::Stable && m_Particles[i].DecayType() != ParticleDecayType::Default) {
         GoResonanceByFeeddown(i, i, 1., Feeddown::Type(static_cast<int>(m_Particles[i].DecayType())));
       }
+
+    FillFeeddownMatrix(Feeddown::Weak);
+    FillFeeddownMatrix(Feeddown::Electromagnetic);
+    FillFeeddownMatrix(Feeddown::Strong);
   }
 
   void ThermalParticleSystem::GoResonanceByFeeddown(int ind, int startind, double BR, Feeddown::Type feeddown) {
@@ -214,7 +214,7 @@ namespace thermalfist {
 
     m_densitiesidnoshift = m_densitiesid;
 
-#pragma omp parallel for reduction(+:densityid) reduction(+:suppression) if(useOpenMP)
+#pragma omp parallel for reduction(+:densityid) reduction(+:suppression) if(m_useOpenMP)
     for (int i = 0; i < m_TPS->ComponentsNumber(); ++i) {
       double dMu = -m_v[i] * m_Pressure;
       m_densitiesid[i] = m_TPS->Particles()[i].Density(m_Parameters, IdealGasFunctions::ParticleDensity, m_UseWidth, m_Chem[i] + dMu);
@@ -9,6 +9,8 @@
 
 #include <fstream>
 
+#include "HRGEventGenerator/RandomGenerators.h"
+
 namespace thermalfist {
 
   int Acceptance::ReadAcceptanceFunction(Acceptance::AcceptanceFunction & func, std::string filename)
@@ -43,4 +45,43 @@ namespace thermalfist {
     return ret;
   }
 
+  bool Acceptance::KinematicWindow::Contains(const SimpleParticle & part) const
+  {
+    double pt = part.GetPt();
+    if (pt < ptmin || pt > ptmax)
+      return false;
+    if (ymin > -1.e100 || ymax < 1.e100) {
+      double y = part.GetY();
+      if (y < ymin || y > ymax)
+        return false;
+    }
+    if (etamin > -1.e100 || etamax < 1.e100) {
+      double eta = part.GetEta();
+      if (eta < etamin || eta > etamax)
+        return false;
+    }
+    return true;
+  }
+
+  void Acceptance::AcceptanceFilter::AddSpecies(long long pdgid, const KinematicWindow & window, const AcceptanceFunction * function)
+  {
+    SpeciesAcceptance acc;
+    acc.window = window;
+    acc.function = function;
+    m_Species[pdgid] = acc;
+  }
+
+  bool Acceptance::AcceptanceFilter::Accept(const SimpleParticle & part) const
+  {
+    std::map<long long, SpeciesAcceptance>::const_iterator it = m_Species.find(part.PDGID);
+    if (it == m_Species.end())
+      return false;
+    const SpeciesAcceptance& acc = it->second;
+    if (!acc.window.Contains(part))
+      return false;
+    if (acc.function != NULL)
+      return RandomGenerators::randgenMT.rand() < acc.function->getAcceptance(part.GetY(), part.GetPt());
+    return true;
+  }
+
 } // namespace thermalfist
\ No newline at end of file
@@ -0,0 +1,502 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include "HRGEventGenerator/BinaryEventWriter.h"
+
+#include <cstring>
+#include <cmath>
+#include <iostream>
+
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "ThermalFISTConfig.h"
+
+namespace thermalfist {
+
+  namespace {
+    const char Magic[8] = { 'T', 'F', 'I', 'S', 'T', 'B', 'E', 'V' };
+    const unsigned int ByteOrderMark = 0x01020304;
+
+    // Upper bound on the deflate compression ratio, used to reject corrupted block headers
+    const unsigned long long MaxCompressionRatio = 1032;
+
+    template<typename T>
+    void AppendColumn(std::vector<char>& buffer, const std::vector<T>& column)
+    {
+      if (column.empty())
+        return;
+      size_t pos = buffer.size();
+      buffer.resize(pos + sizeof(T) * column.size());
+      memcpy(&buffer[pos], &column[0], sizeof(T) * column.size());
+    }
+
+    void AppendRealColumn(std::vector<char>& buffer, const std::vector<double>& column, bool singlePrecision)
+    {
+      if (!singlePrecision) {
+        AppendColumn(buffer, column);
+        return;
+      }
+      if (column.empty())
+        return;
+      size_t pos = buffer.size();
+      buffer.resize(pos + sizeof(float) * column.size());
+      float* dest = reinterpret_cast<float*>(&buffer[pos]);
+      for (size_t i = 0; i < column.size(); ++i)
+        dest[i] = static_cast<float>(column[i]);
+    }
+
+    template<typename T>
+    bool ExtractColumn(const std::vector<char>& buffer, size_t& pos, std::vector<T>& column, size_t size)
+    {
+      if (pos + sizeof(T) * size > buffer.size())
+        return false;
+      column.resize(size);
+      if (size == 0)
+        return true;
+      memcpy(&column[0], &buffer[pos], sizeof(T) * size);
+      pos += sizeof(T) * size;
+      return true;
+    }
+
+    bool ExtractRealColumn(const std::vector<char>& buffer, size_t& pos, std::vector<double>& column, size_t size, bool singlePrecision)
+    {
+      if (!singlePrecision)
+        return ExtractColumn(buffer, pos, column, size);
+      if (pos + sizeof(float) * size > buffer.size())
+        return false;
+      column.resize(size);
+      if (size == 0)
+        return true;
+      const float* src = reinterpret_cast<const float*>(&buffer[pos]);
+      for (size_t i = 0; i < size; ++i)
+        column[i] = src[i];
+      pos += sizeof(float) * size;
+      return true;
+    }
+
+    template<typename T>
+    void WriteValue(std::ofstream& fout, const T& value)
+    {
+      fout.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool ReadValue(std::ifstream& fin, T& value)
+    {
+      fin.read(reinterpret_cast<char*>(&value), sizeof(T));
+      return static_cast<bool>(fin);
+    }
+  }
+
+  bool BinaryEventFormat::CompressionAvailable()
+  {
+#ifdef USE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  BinaryEventWriter::BinaryEventWriter(const std::string& filename, const SimpleEvent::EventOutputConfig& config, bool singlePrecision, int compressionLevel, int eventsPerBlock) :
+    m_Flags(0), m_CompressionLevel(compressionLevel), m_EventsPerBlock(eventsPerBlock)
+  {
+    if (singlePrecision)
+      m_Flags |= BinaryEventFormat::SinglePrecision;
+    if (config.printCoordinates)
+      m_Flags |= BinaryEventFormat::Coordinates;
+    if (config.printMotherPdg)
+      m_Flags |= BinaryEventFormat::MotherPDG;
+    if (config.printDecayEpoch)
+      m_Flags |= BinaryEventFormat::DecayEpoch;
+    if (config.printPhotonsLeptons)
+      m_Flags |= BinaryEventFormat::PhotonsLeptons;
+
+    if (m_CompressionLevel > 9)
+      m_CompressionLevel = 9;
+    if (m_CompressionLevel > 0) {
+      if (BinaryEventFormat::CompressionAvailable())
+        m_Flags |= BinaryEventFormat::Compressed;
+      else {
+        std::cout << "**WARNING** BinaryEventWriter: Thermal-FIST was compiled without zlib, the events will be written uncompressed!" << std::endl;
+        m_CompressionLevel = 0;
+      }
+    }
+
+    if (m_EventsPerBlock < 1)
+      m_EventsPerBlock = 1;
+
+    OpenFile(filename);
+  }
+
+  BinaryEventWriter::~BinaryEventWriter()
+  {
+    CloseFile();
+  }
+
+  bool BinaryEventWriter::OpenFile(const std::string& filename)
+  {
+    if (m_fout.is_open())
+      CloseFile();
+
+    m_fout.open(filename, std::ios::out | std::ios::binary);
+
+    if (!m_fout.is_open())
+      return false;
+
+    m_EventNumber = 0;
+    m_Offsets.assign(1, 0);
+
+    m_fout.write(Magic, sizeof(Magic));
+    WriteValue(m_fout, ByteOrderMark);
+    WriteValue(m_fout, BinaryEventFormat::Version);
+    WriteValue(m_fout, m_Flags);
+
+    return true;
+  }
+
+  void BinaryEventWriter::CloseFile()
+  {
+    if (m_fout.is_open()) {
+      Flush();
+      m_fout.close();
+    }
+  }
+
+  void BinaryEventWriter::AddParticle(const SimpleParticle& part)
+  {
+    m_PDG.push_back(part.PDGID);
+    m_Px.push_back(part.px);
+    m_Py.push_back(part.py);
+    m_Pz.push_back(part.pz);
+    m_M.push_back(part.m);
+    if (m_Flags & BinaryEventFormat::Coordinates) {
+      m_R0.push_back(part.r0);
+      m_Rx.push_back(part.rx);
+      m_Ry.push_back(part.ry);
+      m_Rz.push_back(part.rz);
+    }
+    if (m_Flags & BinaryEventFormat::MotherPDG)
+      m_MotherPDG.push_back(part.MotherPDGID);
+    if (m_Flags & BinaryEventFormat::DecayEpoch)
+      m_Epoch.push_back(part.epoch);
+  }
+
+  bool BinaryEventWriter::WriteEvent(const SimpleEvent& evt)
+  {
+    if (!m_fout.is_open())
+      return false;
+
+    ++m_EventNumber;
+
+    for (size_t i = 0; i < evt.Particles.size(); ++i)
+      AddParticle(evt.Particles[i]);
+
+    if (m_Flags & BinaryEventFormat::PhotonsLeptons) {
+      for (size_t i = 0; i < evt.PhotonsLeptons.size(); ++i)
+        AddParticle(evt.PhotonsLeptons[i]);
+    }
+
+    m_Offsets.push_back(static_cast<unsigned int>(m_PDG.size()));
+    m_Weights.push_back(evt.weight);
+    m_LogWeights.push_back(evt.logweight);
+
+    if (static_cast<int>(m_Weights.size()) >= m_EventsPerBlock)
+      Flush();
+
+    return static_cast<bool>(m_fout);
+  }
+
+  void BinaryEventWriter::Flush()
+  {
+    if (!m_fout.is_open() || m_Weights.empty())
+      return;
+
+    bool singlePrecision = (m_Flags & BinaryEventFormat::SinglePrecision);
+
+    m_Payload.clear();
+    AppendColumn(m_Payload, m_Offsets);
+    AppendColumn(m_Payload, m_Weights);
+    AppendColumn(m_Payload, m_LogWeights);
+    AppendColumn(m_Payload, m_PDG);
+    AppendRealColumn(m_Payload, m_Px, singlePrecision);
+    AppendRealColumn(m_Payload, m_Py, singlePrecision);
+    AppendRealColumn(m_Payload, m_Pz, singlePrecision);
+    AppendRealColumn(m_Payload, m_M, singlePrecision);
+    if (m_Flags & BinaryEventFormat::Coordinates) {
+      AppendRealColumn(m_Payload, m_R0, singlePrecision);
+      AppendRealColumn(m_Payload, m_Rx, singlePrecision);
+      AppendRealColumn(m_Payload, m_Ry, singlePrecision);
+      AppendRealColumn(m_Payload, m_Rz, singlePrecision);
+    }
+    if (m_Flags & BinaryEventFormat::MotherPDG)
+      AppendColumn(m_Payload, m_MotherPDG);
+    if (m_Flags & BinaryEventFormat::DecayEpoch)
+      AppendColumn(m_Payload, m_Epoch);
+
+    unsigned int nevents = static_cast<unsigned int>(m_Weights.size());
+    unsigned int nparticles = static_cast<unsigned int>(m_PDG.size());
+    unsigned long long rawsize = m_Payload.size();
+    unsigned long long storedsize = rawsize;
+    const char* data = m_Payload.empty() ? NULL : &m_Payload[0];
+
+#ifdef USE_ZLIB
+    if (m_Flags & BinaryEventFormat::Compressed) {
+      uLongf destsize = compressBound(static_cast<uLong>(rawsize));
+      m_Compressed.resize(destsize);
+      if (compress2(reinterpret_cast<Bytef*>(&m_Compressed[0]), &destsize,
+        reinterpret_cast<const Bytef*>(data), static_cast<uLong>(rawsize), m_CompressionLevel) != Z_OK) {
+        std::cerr << "**ERROR** BinaryEventWriter: zlib compression failed!" << std::endl;
+        return;
+      }
+      storedsize = destsize;
+      data = &m_Compressed[0];
+    }
+#endif
+
+    WriteValue(m_fout, nevents);
+    WriteValue(m_fout, nparticles);
+    WriteValue(m_fout, rawsize);
+    WriteValue(m_fout, storedsize);
+    m_fout.write(data, storedsize);
+
+    m_Offsets.assign(1, 0);
+    m_Weights.clear();
+    m_LogWeights.clear();
+    m_PDG.clear();
+    m_Px.clear();
+    m_Py.clear();
+    m_Pz.clear();
+    m_M.clear();
+    m_R0.clear();
+    m_Rx.clear();
+    m_Ry.clear();
+    m_Rz.clear();
+    m_MotherPDG.clear();
+    m_Epoch.clear();
+  }
+
+  BinaryEventReader::BinaryEventReader(const std::string& filename) :
+    m_Flags(0), m_EventsRead(0), m_FileSize(0), m_BlockEvents(0), m_BlockEventIndex(0)
+  {
+    if (!filename.empty())
+      OpenFile(filename);
+  }
+
+  BinaryEventReader::~BinaryEventReader()
+  {
+    CloseFile();
+  }
+
+  bool BinaryEventReader::OpenFile(const std::string& filename)
+  {
+    CloseFile();
+
+    m_fin.open(filename, std::ios::in | std::ios::binary);
+    if (!m_fin.is_open()) {
+      std::cerr << "**ERROR** BinaryEventReader: Cannot open file " << filename << std::endl;
+      return false;
+    }
+
+    char magic[8];
+    unsigned int bom = 0, version = 0;
+    m_fin.read(magic, sizeof(magic));
+    if (!m_fin || memcmp(magic, Magic, sizeof(Magic)) != 0
+      || !ReadValue(m_fin, bom) || !ReadValue(m_fin, version) || !ReadValue(m_fin, m_Flags)) {
+      std::cerr << "**ERROR** BinaryEventReader: " << filename << " is not a Thermal-FIST binary event file!" << std::endl;
+      CloseFile();
+      return false;
+    }
+
+    if (bom != ByteOrderMark) {
+      std::cerr << "**ERROR** BinaryEventReader: " << filename << " was written on a machine with a different byte order!" << std::endl;
+      CloseFile();
+      return false;
+    }
+
+    if (version > BinaryEventFormat::Version) {
+      std::cerr << "**ERROR** BinaryEventReader: Unsupported format version " << version << " in " << filename << std::endl;
+      CloseFile();
+      return false;
+    }
+
+    if ((m_Flags & BinaryEventFormat::Compressed) && !BinaryEventFormat::CompressionAvailable()) {
+      std::cerr << "**ERROR** BinaryEventReader: " << filename << " is compressed but Thermal-FIST was compiled without zlib!" << std::endl;
+      CloseFile();
+      return false;
+    }
+
+    std::streampos start = m_fin.tellg();
+    m_fin.seekg(0, std::ios::end);
+    m_FileSize = static_cast<unsigned long long>(m_fin.tellg());
+    m_fin.seekg(start);
+
+    m_EventsRead = 0;
+    m_BlockEvents = m_BlockEventIndex = 0;
+
+    return true;
+  }
+
+  void BinaryEventReader::CloseFile()
+  {
+    if (m_fin.is_open())
+      m_fin.close();
+    m_Flags = 0;
+    m_BlockEvents = m_BlockEventIndex = 0;
+  }
+
+  SimpleEvent::EventOutputConfig BinaryEventReader::OutputConfig() const
+  {
+    SimpleEvent::EventOutputConfig config;
+    config.printCoordinates = (m_Flags & BinaryEventFormat::Coordinates);
+    config.printMotherPdg = (m_Flags & BinaryEventFormat::MotherPDG);
+    config.printDecayEpoch = (m_Flags & BinaryEventFormat::DecayEpoch);
+    // Photons and leptons, if stored, are already part of the particle list
+    config.printPhotonsLeptons = false;
+    return config;
+  }
+
+  bool BinaryEventReader::ReadBlock()
+  {
+    unsigned int nevents = 0, nparticles = 0;
+    unsigned long long rawsize = 0, storedsize = 0;
+    if (!ReadValue(m_fin, nevents) || !ReadValue(m_fin, nparticles)
+      || !ReadValue(m_fin, rawsize) || !ReadValue(m_fin, storedsize))
+      return false;
+
+    // The payload size follows from the block header, the stored size is limited by the rest of the file
+    bool compressed = (m_Flags & BinaryEventFormat::Compressed);
+    unsigned long long realsize = (m_Flags & BinaryEventFormat::SinglePrecision) ? sizeof(float) : sizeof(double);
+    unsigned long long expsize = sizeof(unsigned int) * (nevents + 1ULL) + 2 * sizeof(double) * nevents
+      + (sizeof(long long) + 4 * realsize) * nparticles;
+    if (m_Flags & BinaryEventFormat::Coordinates)
+      expsize += 4 * realsize * nparticles;
+    if (m_Flags & BinaryEventFormat::MotherPDG)
+      expsize += sizeof(long long) * nparticles;
+    if (m_Flags & BinaryEventFormat::DecayEpoch)
+      expsize += sizeof(int) * nparticles;
+    unsigned long long bytesleft = m_FileSize - static_cast<unsigned long long>(m_fin.tellg());
+    if (rawsize != expsize || storedsize > bytesleft
+      || (!compressed && storedsize != rawsize)
+      || (compressed && rawsize > MaxCompressionRatio * storedsize)) {
+      std::cerr << "**ERROR** BinaryEventReader: Corrupted event block!" << std::endl;
+      return false;
+    }
+
+    std::vector<char>& stored = compressed ? m_Compressed : m_Payload;
+    stored.resize(storedsize);
+    if (storedsize > 0) {
+      m_fin.read(&stored[0], storedsize);
+      if (!m_fin) {
+        std::cerr << "**ERROR** BinaryEventReader: Unexpected end of file!" << std::endl;
+        return false;
+      }
+    }
+
+#ifdef USE_ZLIB
+    if (compressed) {
+      m_Payload.resize(rawsize);
+      uLongf destsize = static_cast<uLongf>(rawsize);
+      if (rawsize > 0 && (uncompress(reinterpret_cast<Bytef*>(&m_Payload[0]), &destsize,
+        reinterpret_cast<const Bytef*>(&m_Compressed[0]), static_cast<uLong>(storedsize)) != Z_OK
+        || destsize != rawsize)) {
+        std::cerr << "**ERROR** BinaryEventReader: zlib decompression failed!" << std::endl;
+        return false;
+      }
+    }
+#endif
+
+    bool singlePrecision = (m_Flags & BinaryEventFormat::SinglePrecision);
+    size_t pos = 0;
+    bool ok = ExtractColumn(m_Payload, pos, m_Offsets, nevents + static_cast<size_t>(1))
+      && ExtractColumn(m_Payload, pos, m_Weights, nevents)
+      && ExtractColumn(m_Payload, pos, m_LogWeights, nevents)
+      && ExtractColumn(m_Payload, pos, m_PDG, nparticles)
+      && ExtractRealColumn(m_Payload, pos, m_Px, nparticles, singlePrecision)
+      && ExtractRealColumn(m_Payload, pos, m_Py, nparticles, singlePrecision)
+      && ExtractRealColumn(m_Payload, pos, m_Pz, nparticles, singlePrecision)
+      && ExtractRealColumn(m_Payload, pos, m_M, nparticles, singlePrecision);
+    if (ok && (m_Flags & BinaryEventFormat::Coordinates)) {
+      ok = ExtractRealColumn(m_Payload, pos, m_R0, nparticles, singlePrecision)
+        && ExtractRealColumn(m_Payload, pos, m_Rx, nparticles, singlePrecision)
+        && ExtractRealColumn(m_Payload, pos, m_Ry, nparticles, singlePrecision)
+        && ExtractRealColumn(m_Payload, pos, m_Rz, nparticles, singlePrecision);
+    }
+    if (ok && (m_Flags & BinaryEventFormat::MotherPDG))
+      ok = ExtractColumn(m_Payload, pos, m_MotherPDG, nparticles);
+    if (ok && (m_Flags & BinaryEventFormat::DecayEpoch))
+      ok = ExtractColumn(m_Payload, pos, m_Epoch, nparticles);
+
+    // Event offsets must start at zero, not decrease, and end at the number of particles
+    if (ok && m_Offsets[0] != 0)
+      ok = false;
+    for (unsigned int ev = 0; ok && ev < nevents; ++ev)
+      if (m_Offsets[ev + 1] < m_Offsets[ev])
+        ok = false;
+
+    if (!ok || m_Offsets[nevents] != nparticles) {
+      std::cerr << "**ERROR** BinaryEventReader: Corrupted event block!" << std::endl;
+      return false;
+    }
+
+    m_BlockEvents = nevents;
+    m_BlockEventIndex = 0;
+    return true;
+  }
+
+  bool BinaryEventReader::ReadEvent(SimpleEvent& evt)
+  {
+    if (!m_fin.is_open())
+      return false;
+
+    while (m_BlockEventIndex >= m_BlockEvents) {
+      if (!ReadBlock()) {
+        m_BlockEvents = m_BlockEventIndex = 0;
+        return false;
+      }
+    }
+
+    unsigned int ev = m_BlockEventIndex++;
+    evt = SimpleEvent();
+    evt.weight = m_Weights[ev];
+    evt.logweight = m_LogWeights[ev];
+
+    unsigned int first = m_Offsets[ev], last = m_Offsets[ev + 1];
+    evt.Particles.resize(last - first);
+    for (unsigned int i = first; i < last; ++i) {
+      SimpleParticle& part = evt.Particles[i - first];
+      part = SimpleParticle(m_Px[i], m_Py[i], m_Pz[i], m_M[i], m_PDG[i]);
+      if (m_Flags & BinaryEventFormat::Coordinates) {
+        part.r0 = m_R0[i];
+        part.rx = m_Rx[i];
+        part.ry = m_Ry[i];
+        part.rz = m_Rz[i];
+      }
+      if (m_Flags & BinaryEventFormat::MotherPDG)
+        part.MotherPDGID = m_MotherPDG[i];
+      if (m_Flags & BinaryEventFormat::DecayEpoch)
+        part.epoch = m_Epoch[i];
+    }
+
+    ++m_EventsRead;
+    return true;
+  }
+
+  long long BinaryEventReader::ConvertEvents(EventWriter& writer, long long maxevents)
+  {
+    long long converted = 0;
+    SimpleEvent evt;
+    while ((maxevents < 0 || converted < maxevents) && ReadEvent(evt)) {
+      if (!writer.WriteEvent(evt))
+        break;
+      ++converted;
+    }
+    return converted;
+  }
+
+}
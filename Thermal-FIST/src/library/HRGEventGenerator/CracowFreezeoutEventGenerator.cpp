@@ -17,19 +17,26 @@
 namespace thermalfist {
 
   CracowFreezeoutEventGenerator::CracowFreezeoutEventGenerator() : EventGeneratorBase(),
-    m_T(0.150), m_RoverTauH(1.0), m_EtaMax(0.5)
+    m_T(0.150), m_RoverTauH(1.0), m_EtaMax(0.5), m_FreezeoutTable(NULL)
   {
   }
 
   CracowFreezeoutEventGenerator::CracowFreezeoutEventGenerator(ThermalParticleSystem* TPS, const EventGeneratorConfiguration& config, double T, double RoverTauH, double etamax) :
     EventGeneratorBase(),
-    m_T(T), m_RoverTauH(RoverTauH), m_EtaMax(etamax)
+    m_T(T), m_RoverTauH(RoverTauH), m_EtaMax(etamax), m_FreezeoutTable(NULL)
   {
     SetConfiguration(TPS, config);
 
     //SetMomentumGenerators();
   }
 
+  CracowFreezeoutEventGenerator::~CracowFreezeoutEventGenerator()
+  {
+    ClearMomentumGenerators();
+    if (m_FreezeoutTable != NULL)
+      delete m_FreezeoutTable;
+  }
+
   void CracowFreezeoutEventGenerator::SetParameters(double T, double RoverTauH, double etamax)
   {
     m_T = T;
@@ -48,11 +55,16 @@ namespace thermalfist {
     // Find \tau_H from Veff / (\delta \eta) = \pi \tau_H R^2 where R = m_RoverTauH * \tau_H
     double tauH = pow(m_THM->Volume() / (2. * m_EtaMax) / xMath::Pi() / m_RoverTauH / m_RoverTauH, 1. / 3.);
 
+    // The freeze-out parametrization is tabulated once for all species
+    if (m_FreezeoutTable != NULL)
+      delete m_FreezeoutTable;
+    m_FreezeoutTable = new BoostInvariantFreezeoutTable(CracowFreezeoutParametrization(m_RoverTauH, tauH));
+
     if (m_THM != NULL) {
       for (size_t i = 0; i < m_THM->TPS()->Particles().size(); ++i) {
         const ThermalParticle& part = m_THM->TPS()->Particles()[i];
         //m_MomentumGens.push_back(new RandomGenerators::CracowFreezeoutMomentumGenerator(m_T, m_RoverTauH, m_EtaMax, part.Mass(), part.Statistics(), m_THM->FullIdealChemicalPotential(i)));
-        m_MomentumGens.push_back(new RandomGenerators::BoostInvariantMomentumGenerator(new CracowFreezeoutParametrization(m_RoverTauH, tauH), GetTkin(), GetEtaMax(), part.Mass(), part.Statistics(), m_THM->FullIdealChemicalPotential(i)));
+        m_MomentumGens.push_back(new RandomGenerators::BoostInvariantMomentumGenerator(new CracowFreezeoutParametrization(m_RoverTauH, tauH), GetTkin(), GetEtaMax(), part.Mass(), part.Statistics(), m_THM->FullIdealChemicalPotential(i), m_FreezeoutTable));
 
         double T = m_THM->Parameters().T;
         double Mu = m_THM->FullIdealChemicalPotential(i);
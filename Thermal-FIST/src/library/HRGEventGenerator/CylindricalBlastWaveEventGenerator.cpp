@@ -22,7 +22,7 @@ namespace thermalfist {
 
   CylindricalBlastWaveEventGenerator::CylindricalBlastWaveEventGenerator(ThermalParticleSystem * TPS, const EventGeneratorConfiguration & config, double T, double betas, double etamax, double npow, double Rperp) : 
     EventGeneratorBase(),
-    m_T(T), m_BetaS(betas), m_EtaMax(etamax), m_n(npow), m_Rperp(Rperp)
+    m_T(T), m_BetaS(betas), m_EtaMax(etamax), m_n(npow), m_Rperp(Rperp), m_FreezeoutTable(NULL)
   {
     SetConfiguration(TPS, config);
 
@@ -31,7 +31,7 @@ namespace thermalfist {
 
   CylindricalBlastWaveEventGenerator::CylindricalBlastWaveEventGenerator(ThermalModelBase *THM, double T, double betas, double etamax, double npow, bool /*onlyStable*/, EventGeneratorConfiguration::ModelType EV, ThermalModelBase *THMEVVDW) :
     EventGeneratorBase(),
-    m_T(T), m_BetaS(betas), m_EtaMax(etamax), m_n(npow), m_Rperp(6.5) {
+    m_T(T), m_BetaS(betas), m_EtaMax(etamax), m_n(npow), m_Rperp(6.5), m_FreezeoutTable(NULL) {
     EventGeneratorConfiguration::ModelType modeltype = EV;
     EventGeneratorConfiguration::Ensemble ensemble = EventGeneratorConfiguration::GCE;
     if (THM->Ensemble() == ThermalModelBase::CE)
@@ -72,6 +72,13 @@ namespace thermalfist {
     //SetMomentumGenerators();
   }
 
+  CylindricalBlastWaveEventGenerator::~CylindricalBlastWaveEventGenerator()
+  {
+    ClearMomentumGenerators();
+    if (m_FreezeoutTable != NULL)
+      delete m_FreezeoutTable;
+  }
+
   void CylindricalBlastWaveEventGenerator::SetParameters(double T, double betas, double etamax, double npow) {
     m_T = T;
     m_BetaS = betas;
@@ -98,10 +105,16 @@ namespace thermalfist {
     // Find \tau_H from Veff / (\delta \eta) = \pi \tau R^2 * I where I is an integral over transverse velocity profile computed numerically
     double tau = m_THM->Volume() / (2. * GetEtaMax()) / (2. * xMath::Pi()) / GetRperp() / GetRperp() / GetVeffIntegral();
 
+    // The freeze-out parametrization is tabulated once for all species.
+    // It has no explicit inverse of the zeta distribution, so the momentum generators only need the table.
+    if (m_FreezeoutTable != NULL)
+      delete m_FreezeoutTable;
+    m_FreezeoutTable = new BoostInvariantFreezeoutTable(CylindricalBlastWaveParametrization(GetBetaSurface(), GetNPow(), tau, GetRperp()));
+
     if (m_THM != NULL) {
       for (size_t i = 0; i < m_THM->TPS()->Particles().size(); ++i) {
         const ThermalParticle& part = m_THM->TPS()->Particles()[i];
-        m_MomentumGens.push_back(new RandomGenerators::BoostInvariantMomentumGenerator(new CylindricalBlastWaveParametrization(GetBetaSurface(), GetNPow(), tau, GetRperp()), GetTkin(), GetEtaMax(), part.Mass(), part.Statistics(), m_THM->FullIdealChemicalPotential(i)));
+        m_MomentumGens.push_back(new RandomGenerators::BoostInvariantMomentumGenerator(NULL, GetTkin(), GetEtaMax(), part.Mass(), part.Statistics(), m_THM->FullIdealChemicalPotential(i), m_FreezeoutTable));
 
         double T = m_THM->Parameters().T;
         double Mu = m_THM->FullIdealChemicalPotential(i);
@@ -0,0 +1,260 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include "HRGEventGenerator/EVOverlapIndex.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "HRGEventGenerator/ParticleDecaysMC.h"
+
+namespace thermalfist {
+
+  EVRadiiTable::EVRadiiTable(const std::vector< std::vector<double> >& radii) :
+    m_NumberOfClasses(0), m_MaxRadius(0.)
+  {
+    int Nspecies = radii.size();
+    m_Classes.resize(Nspecies);
+
+    // Representative species of each class
+    std::vector<int> representatives;
+    for (int i = 0; i < Nspecies; ++i) {
+      m_Classes[i] = -1;
+      for (size_t cl = 0; cl < representatives.size(); ++cl) {
+        if (radii[i] == radii[representatives[cl]]) {
+          m_Classes[i] = cl;
+          break;
+        }
+      }
+      if (m_Classes[i] == -1) {
+        m_Classes[i] = representatives.size();
+        representatives.push_back(i);
+      }
+    }
+
+    m_NumberOfClasses = representatives.size();
+    m_Radii.resize(m_NumberOfClasses * m_NumberOfClasses);
+    m_MaxRadii.assign(m_NumberOfClasses, 0.);
+    for (int cl1 = 0; cl1 < m_NumberOfClasses; ++cl1) {
+      for (int cl2 = 0; cl2 < m_NumberOfClasses; ++cl2) {
+        double r = radii[representatives[cl1]][representatives[cl2]];
+        m_Radii[cl1 * m_NumberOfClasses + cl2] = r;
+        m_MaxRadii[cl1] = std::max(m_MaxRadii[cl1], r);
+      }
+      m_MaxRadius = std::max(m_MaxRadius, m_MaxRadii[cl1]);
+    }
+  }
+
+  EVOverlapIndex::EVOverlapIndex(const EVRadiiTable* radii)
+  {
+    SetRadiiTable(radii);
+  }
+
+  void EVOverlapIndex::SetRadiiTable(const EVRadiiTable* radii)
+  {
+    m_RadiiTable = radii;
+
+    // Grids for the Lorentz factors up to 2, 8, and 32, the cell size scales with the maximum reach
+    m_Grids.resize(3);
+    double rmax = 1.;
+    if (m_RadiiTable != NULL && m_RadiiTable->MaxRadius() > 0.)
+      rmax = m_RadiiTable->MaxRadius();
+    double gammaThreshold = 2.;
+    for (size_t ig = 0; ig < m_Grids.size(); ++ig) {
+      m_Grids[ig].GammaThreshold = gammaThreshold;
+      m_Grids[ig].CellSize = 4. * rmax * gammaThreshold;
+      m_Grids[ig].Head.clear();
+      gammaThreshold *= 4.;
+    }
+
+    Clear();
+  }
+
+  void EVOverlapIndex::Clear(int expectedSize)
+  {
+    m_Particles.clear();
+    m_Ids.clear();
+    m_Next.clear();
+    m_Fast.clear();
+    for (size_t ig = 0; ig < m_Grids.size(); ++ig) {
+      Grid& grid = m_Grids[ig];
+      grid.Members.clear();
+      grid.GammaStored = 1.;
+      grid.TimeCellMin = 0;
+      grid.TimeCellMax = -1;
+      if (static_cast<int>(grid.Head.size()) < 2 * expectedSize || grid.Head.empty())
+        Rehash(grid, 2 * expectedSize);
+      else
+        std::fill(grid.Head.begin(), grid.Head.end(), -1);
+    }
+  }
+
+  int EVOverlapIndex::CellIndex(const Grid& grid, double x) const
+  {
+    double ind = floor(x / grid.CellSize);
+    if (ind > 1.e9)
+      return 1000000000;
+    if (ind < -1.e9)
+      return -1000000000;
+    return static_cast<int>(ind);
+  }
+
+  int EVOverlapIndex::Bucket(const Grid& grid, int it, int ix, int iy, int iz) const
+  {
+    unsigned int h = static_cast<unsigned int>(it) * 2654435761U;
+    h ^= static_cast<unsigned int>(ix) * 73856093U;
+    h ^= static_cast<unsigned int>(iy) * 19349663U;
+    h ^= static_cast<unsigned int>(iz) * 83492791U;
+    return static_cast<int>(h & static_cast<unsigned int>(grid.HashMask));
+  }
+
+  void EVOverlapIndex::Rehash(Grid& grid, int size)
+  {
+    int tsize = 64;
+    while (tsize < size)
+      tsize *= 2;
+    grid.Head.assign(tsize, -1);
+    grid.HashMask = tsize - 1;
+
+    for (size_t i = 0; i < grid.Members.size(); ++i) {
+      int index = grid.Members[i];
+      const SimpleParticle& part = m_Particles[index];
+      int bucket = Bucket(grid, CellIndex(grid, part.r0), CellIndex(grid, part.rx), CellIndex(grid, part.ry), CellIndex(grid, part.rz));
+      m_Next[index] = grid.Head[bucket];
+      grid.Head[bucket] = index;
+    }
+  }
+
+  void EVOverlapIndex::InsertInGrid(Grid& grid, int index)
+  {
+    const SimpleParticle& part = m_Particles[index];
+    grid.GammaStored = std::max(grid.GammaStored, part.p0 / part.m);
+    int it = CellIndex(grid, part.r0);
+    if (grid.Members.empty()) {
+      grid.TimeCellMin = grid.TimeCellMax = it;
+    }
+    else {
+      grid.TimeCellMin = std::min(grid.TimeCellMin, it);
+      grid.TimeCellMax = std::max(grid.TimeCellMax, it);
+    }
+    grid.Members.push_back(index);
+
+    if (2 * grid.Members.size() > grid.Head.size()) {
+      Rehash(grid, 4 * grid.Members.size());
+      return;
+    }
+
+    int bucket = Bucket(grid, it, CellIndex(grid, part.rx), CellIndex(grid, part.ry), CellIndex(grid, part.rz));
+    m_Next[index] = grid.Head[bucket];
+    grid.Head[bucket] = index;
+  }
+
+  void EVOverlapIndex::Insert(const SimpleParticle& part, int id)
+  {
+    if (m_RadiiTable == NULL || m_RadiiTable->MaxRadius(id) == 0.)
+      return;
+
+    int index = m_Particles.size();
+    m_Particles.push_back(part);
+    m_Ids.push_back(id);
+    m_Next.push_back(-1);
+
+    if (part.m > 0.) {
+      double gamma = part.p0 / part.m;
+      for (size_t ig = 0; ig < m_Grids.size(); ++ig) {
+        if (gamma <= m_Grids[ig].GammaThreshold) {
+          InsertInGrid(m_Grids[ig], index);
+          return;
+        }
+      }
+    }
+
+    m_Fast.push_back(index);
+  }
+
+  bool EVOverlapIndex::CheckPair(const SimpleParticle& cand, int id, int ipart) const
+  {
+    double r = m_RadiiTable->Radius(m_Ids[ipart], id);
+    if (r == 0.0)
+      return false;
+    return (ParticleDecaysMC::ParticleDistanceSquared(m_Particles[ipart], cand) <= 4. * r * r);
+  }
+
+  bool EVOverlapIndex::CheckGrid(const Grid& grid, const SimpleParticle& cand, int id, double gamma, double rmax) const
+  {
+    int gridSize = grid.Members.size();
+    if (gridSize == 0)
+      return false;
+
+    // Small safety margin for round-off errors
+    double R0 = 4. * rmax * std::max(gamma, grid.GammaStored) * (1. + 1.e-9) + 1.e-9;
+
+    // Estimate the number of cells to examine, use brute force if it exceeds the number of particles
+    long long ncells = 0;
+    if (gamma > 0.) {
+      for (int it = grid.TimeCellMin; it <= grid.TimeCellMax && ncells <= gridSize; ++it) {
+        double dt = std::max(fabs(cand.r0 - it * grid.CellSize), fabs(cand.r0 - (it + 1) * grid.CellSize));
+        double R = R0 + dt;
+        long long nx = CellIndex(grid, cand.rx + R) - CellIndex(grid, cand.rx - R) + 1;
+        long long ny = CellIndex(grid, cand.ry + R) - CellIndex(grid, cand.ry - R) + 1;
+        long long nz = CellIndex(grid, cand.rz + R) - CellIndex(grid, cand.rz - R) + 1;
+        ncells += nx * ny * nz;
+      }
+    }
+
+    if (gamma <= 0. || ncells > gridSize) {
+      for (int i = 0; i < gridSize; ++i) {
+        if (CheckPair(cand, id, grid.Members[i]))
+          return true;
+      }
+      return false;
+    }
+
+    for (int it = grid.TimeCellMin; it <= grid.TimeCellMax; ++it) {
+      double dt = std::max(fabs(cand.r0 - it * grid.CellSize), fabs(cand.r0 - (it + 1) * grid.CellSize));
+      double R = R0 + dt;
+      int ixmax = CellIndex(grid, cand.rx + R), iymax = CellIndex(grid, cand.ry + R), izmax = CellIndex(grid, cand.rz + R);
+      for (int ix = CellIndex(grid, cand.rx - R); ix <= ixmax; ++ix) {
+        for (int iy = CellIndex(grid, cand.ry - R); iy <= iymax; ++iy) {
+          for (int iz = CellIndex(grid, cand.rz - R); iz <= izmax; ++iz) {
+            for (int ipart = grid.Head[Bucket(grid, it, ix, iy, iz)]; ipart != -1; ipart = m_Next[ipart]) {
+              if (CheckPair(cand, id, ipart))
+                return true;
+            }
+          }
+        }
+      }
+    }
+
+    return false;
+  }
+
+  bool EVOverlapIndex::CheckOverlap(const SimpleParticle& cand, int id) const
+  {
+    if (m_RadiiTable == NULL || m_Particles.empty())
+      return false;
+
+    double rmax = m_RadiiTable->MaxRadius(id);
+    if (rmax == 0.)
+      return false;
+
+    double gamma = (cand.m > 0.) ? cand.p0 / cand.m : -1.;
+
+    for (size_t ig = 0; ig < m_Grids.size(); ++ig) {
+      if (CheckGrid(m_Grids[ig], cand, id, gamma, rmax))
+        return true;
+    }
+
+    for (size_t i = 0; i < m_Fast.size(); ++i) {
+      if (CheckPair(cand, id, m_Fast[i]))
+        return true;
+    }
+
+    return false;
+  }
+
+} // namespace thermalfist
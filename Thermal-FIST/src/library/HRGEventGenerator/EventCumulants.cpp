@@ -0,0 +1,506 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include "HRGEventGenerator/EventCumulants.h"
+
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+#include "HRGEventGenerator/RandomGenerators.h"
+
+namespace thermalfist {
+
+  EventObservable::EventObservable(const ThermalParticleSystem* TPS, ConservedCharge::Name chg)
+  {
+    if (TPS == NULL)
+      return;
+    for (int i = 0; i < TPS->ComponentsNumber(); ++i) {
+      double charge = TPS->Particle(i).GetCharge(chg);
+      if (charge != 0.)
+        AddSpecies(TPS->Particle(i).PdgId(), charge);
+    }
+  }
+
+  void EventObservable::AddSpecies(long long pdgid, double c)
+  {
+    m_Coefficients[pdgid] += c;
+  }
+
+  double EventObservable::Value(const SimpleEvent& ev) const
+  {
+    double ret = 0.;
+    for (size_t i = 0; i < ev.Particles.size(); ++i) {
+      std::map<long long, double>::const_iterator it = m_Coefficients.find(ev.Particles[i].PDGID);
+      if (it != m_Coefficients.end())
+        ret += it->second;
+    }
+    return ret;
+  }
+
+  EventObservable EventObservable::ParticleNumber(long long pdgid)
+  {
+    EventObservable ret;
+    ret.AddSpecies(pdgid, 1.);
+    return ret;
+  }
+
+  EventObservable EventObservable::NetParticleNumber(long long pdgid)
+  {
+    EventObservable ret;
+    ret.AddSpecies(pdgid, 1.);
+    ret.AddSpecies(-pdgid, -1.);
+    return ret;
+  }
+
+  namespace {
+    // All compositions of order into the components ind, ind+1, ... of exponents
+    void EnumerateExponents(std::vector<int>& exponents, int ind, int order, std::vector< std::vector<int> >& ret)
+    {
+      if (ind == static_cast<int>(exponents.size()) - 1) {
+        exponents[ind] = order;
+        ret.push_back(exponents);
+        return;
+      }
+      for (int k = order; k >= 0; --k) {
+        exponents[ind] = k;
+        EnumerateExponents(exponents, ind + 1, order - k, ret);
+      }
+      exponents[ind] = 0;
+    }
+
+    double Binomial(int n, int k)
+    {
+      double ret = 1.;
+      for (int i = 1; i <= k; ++i)
+        ret = ret * (n - k + i) / i;
+      return ret;
+    }
+  }
+
+  EventCumulantAccumulator::EventCumulantAccumulator(int numberOfObservables, int maxOrder, ErrorEstimate errors, int numberOfSamples) :
+    m_NumberOfObservables(numberOfObservables),
+    m_MaxOrder(maxOrder),
+    m_ErrorEstimate(errors),
+    m_NextSample(0),
+    m_RandomGenerator(1U)
+  {
+    if (m_ErrorEstimate != NoErrors && numberOfSamples < 2)
+      numberOfSamples = (m_ErrorEstimate == Bootstrap) ? 100 : 10;
+    if (m_ErrorEstimate == NoErrors)
+      numberOfSamples = 0;
+    m_Samples.resize(numberOfSamples);
+    if (m_ErrorEstimate == Bootstrap)
+      m_RandomGenerator.seed(RandomGenerators::randgenMT.randInt());
+    Initialize();
+  }
+
+  EventCumulantAccumulator::EventCumulantAccumulator(const std::vector<EventObservable>& observables, int maxOrder, ErrorEstimate errors, int numberOfSamples) :
+    m_NumberOfObservables(observables.size()),
+    m_MaxOrder(maxOrder),
+    m_ErrorEstimate(errors),
+    m_Observables(observables),
+    m_NextSample(0),
+    m_RandomGenerator(1U)
+  {
+    if (m_ErrorEstimate != NoErrors && numberOfSamples < 2)
+      numberOfSamples = (m_ErrorEstimate == Bootstrap) ? 100 : 10;
+    if (m_ErrorEstimate == NoErrors)
+      numberOfSamples = 0;
+    m_Samples.resize(numberOfSamples);
+    if (m_ErrorEstimate == Bootstrap)
+      m_RandomGenerator.seed(RandomGenerators::randgenMT.randInt());
+    Initialize();
+  }
+
+  void EventCumulantAccumulator::Initialize()
+  {
+    if (m_NumberOfObservables < 1) {
+      printf("**WARNING** EventCumulantAccumulator: Number of observables is %d, using one observable\n", m_NumberOfObservables);
+      m_NumberOfObservables = 1;
+    }
+    if (m_MaxOrder < 1) {
+      printf("**WARNING** EventCumulantAccumulator: Maximum order is %d, using the first order\n", m_MaxOrder);
+      m_MaxOrder = 1;
+    }
+
+    m_Exponents.clear();
+    std::vector<int> exponents(m_NumberOfObservables, 0);
+    for (int order = 0; order <= m_MaxOrder; ++order)
+      EnumerateExponents(exponents, 0, order, m_Exponents);
+
+    m_MultiIndices.clear();
+    for (size_t j = 0; j < m_Exponents.size(); ++j) {
+      long long key = 0;
+      for (int k = 0; k < m_NumberOfObservables; ++k)
+        key = key * (m_MaxOrder + 1) + m_Exponents[j][k];
+      m_MultiIndices[key] = j;
+    }
+
+    int nindices = m_Exponents.size();
+    m_Parent.assign(nindices, -1);
+    m_ParentComponent.assign(nindices, -1);
+    std::vector<int> orders(nindices, 0);
+    for (int j = 1; j < nindices; ++j) {
+      std::vector<int> parent = m_Exponents[j];
+      for (int k = 0; k < m_NumberOfObservables; ++k) {
+        orders[j] += parent[k];
+        if (parent[k] > 0 && m_ParentComponent[j] == -1) {
+          parent[k]--;
+          m_ParentComponent[j] = k;
+        }
+      }
+      m_Parent[j] = MultiIndex(parent);
+    }
+
+    // Terms with beta < alpha, the first order central moments vanish
+    m_Terms.assign(nindices, std::vector<UpdateTerm>());
+    std::vector<int> gamma(m_NumberOfObservables);
+    for (int ia = 0; ia < nindices; ++ia) {
+      if (orders[ia] < 2)
+        continue;
+      for (int ib = 0; ib < nindices && orders[ib] < orders[ia]; ++ib) {
+        if (orders[ib] == 1)
+          continue;
+        bool fl = true;
+        double binom = 1.;
+        for (int k = 0; k < m_NumberOfObservables && fl; ++k) {
+          if (m_Exponents[ib][k] > m_Exponents[ia][k])
+            fl = false;
+          else {
+            gamma[k] = m_Exponents[ia][k] - m_Exponents[ib][k];
+            binom *= Binomial(m_Exponents[ia][k], m_Exponents[ib][k]);
+          }
+        }
+        if (!fl)
+          continue;
+        UpdateTerm term;
+        term.Beta = ib;
+        term.Gamma = MultiIndex(gamma);
+        term.Binomial = binom;
+        m_Terms[ia].push_back(term);
+      }
+    }
+
+    m_Values.resize(m_NumberOfObservables);
+    m_Delta.resize(m_NumberOfObservables);
+    m_PowersA.resize(nindices);
+    m_PowersB.resize(nindices);
+
+    Clear();
+  }
+
+  int EventCumulantAccumulator::MultiIndex(const std::vector<int>& exponents) const
+  {
+    long long key = 0;
+    for (int k = 0; k < m_NumberOfObservables; ++k)
+      key = key * (m_MaxOrder + 1) + exponents[k];
+    std::map<long long, int>::const_iterator it = m_MultiIndices.find(key);
+    if (it == m_MultiIndices.end())
+      return -1;
+    return it->second;
+  }
+
+  void EventCumulantAccumulator::Clear()
+  {
+    m_Sums.Events = 0;
+    m_Sums.Means.assign(m_NumberOfObservables, 0.);
+    m_Sums.Moments.assign(m_Exponents.size(), 0.);
+    for (size_t i = 0; i < m_Samples.size(); ++i)
+      m_Samples[i] = m_Sums;
+    m_NextSample = 0;
+  }
+
+  void EventCumulantAccumulator::AddEvent(const SimpleEvent& ev)
+  {
+    if (static_cast<int>(m_Observables.size()) != m_NumberOfObservables) {
+      printf("**WARNING** EventCumulantAccumulator::AddEvent: The observables are not specified, use AddValues() instead\n");
+      return;
+    }
+    for (int k = 0; k < m_NumberOfObservables; ++k)
+      m_Values[k] = m_Observables[k].Value(ev);
+    AddValues(m_Values, ev.weight);
+  }
+
+  void EventCumulantAccumulator::AddValues(const std::vector<double>& values, double weight)
+  {
+    if (static_cast<int>(values.size()) != m_NumberOfObservables) {
+      printf("**WARNING** EventCumulantAccumulator::AddValues: Expected %d values, got %d\n", m_NumberOfObservables, static_cast<int>(values.size()));
+      return;
+    }
+
+    AddPoint(m_Sums, &values[0], weight);
+
+    if (m_Samples.size() == 0)
+      return;
+
+    if (m_ErrorEstimate == Subsampling) {
+      AddPoint(m_Samples[m_NextSample % m_Samples.size()], &values[0], weight);
+      m_NextSample++;
+    }
+    else if (m_ErrorEstimate == Bootstrap) {
+      for (size_t i = 0; i < m_Samples.size(); ++i) {
+        int multiplicity = RandomGenerators::RandomPoisson(1., m_RandomGenerator);
+        if (multiplicity > 0)
+          AddPoint(m_Samples[i], &values[0], multiplicity * weight);
+      }
+    }
+  }
+
+  void EventCumulantAccumulator::AddPoint(MomentSums& sums, const double* values, double weight)
+  {
+    if (weight == 0.)
+      return;
+
+    sums.Events++;
+
+    double WA = sums.Moments[0];
+    if (WA == 0.) {
+      for (int k = 0; k < m_NumberOfObservables; ++k)
+        sums.Means[k] = values[k];
+      sums.Moments[0] = weight;
+      return;
+    }
+
+    double W = WA + weight;
+    for (int k = 0; k < m_NumberOfObservables; ++k)
+      m_Delta[k] = values[k] - sums.Means[k];
+
+    // Powers of the shifts of the means of the accumulated sums and of the new event
+    double fA = -weight / W, fB = WA / W;
+    m_PowersA[0] = m_PowersB[0] = 1.;
+    for (size_t j = 1; j < m_PowersA.size(); ++j) {
+      double dk = m_Delta[m_ParentComponent[j]];
+      m_PowersA[j] = m_PowersA[m_Parent[j]] * fA * dk;
+      m_PowersB[j] = m_PowersB[m_Parent[j]] * fB * dk;
+    }
+
+    // Descending order, such that the lower moments are not yet updated
+    for (int ia = static_cast<int>(m_Terms.size()) - 1; ia > 0; --ia) {
+      const std::vector<UpdateTerm>& terms = m_Terms[ia];
+      if (terms.empty())
+        continue;
+      double add = weight * m_PowersB[ia];
+      for (size_t it = 0; it < terms.size(); ++it)
+        add += terms[it].Binomial * sums.Moments[terms[it].Beta] * m_PowersA[terms[it].Gamma];
+      sums.Moments[ia] += add;
+    }
+
+    sums.Moments[0] = W;
+    for (int k = 0; k < m_NumberOfObservables; ++k)
+      sums.Means[k] += weight / W * m_Delta[k];
+  }
+
+  void EventCumulantAccumulator::MergeSums(MomentSums& sums, const MomentSums& other)
+  {
+    if (other.Moments[0] == 0.)
+      return;
+
+    if (sums.Moments[0] == 0.) {
+      sums = other;
+      return;
+    }
+
+    double WA = sums.Moments[0], WB = other.Moments[0];
+    double W = WA + WB;
+    for (int k = 0; k < m_NumberOfObservables; ++k)
+      m_Delta[k] = other.Means[k] - sums.Means[k];
+
+    double fA = -WB / W, fB = WA / W;
+    m_PowersA[0] = m_PowersB[0] = 1.;
+    for (size_t j = 1; j < m_PowersA.size(); ++j) {
+      double dk = m_Delta[m_ParentComponent[j]];
+      m_PowersA[j] = m_PowersA[m_Parent[j]] * fA * dk;
+      m_PowersB[j] = m_PowersB[m_Parent[j]] * fB * dk;
+    }
+
+    for (int ia = static_cast<int>(m_Terms.size()) - 1; ia > 0; --ia) {
+      const std::vector<UpdateTerm>& terms = m_Terms[ia];
+      if (terms.empty())
+        continue;
+      double add = other.Moments[ia];
+      for (size_t it = 0; it < terms.size(); ++it)
+        add += terms[it].Binomial * (sums.Moments[terms[it].Beta] * m_PowersA[terms[it].Gamma] + other.Moments[terms[it].Beta] * m_PowersB[terms[it].Gamma]);
+      sums.Moments[ia] += add;
+    }
+
+    sums.Moments[0] = W;
+    sums.Events += other.Events;
+    for (int k = 0; k < m_NumberOfObservables; ++k)
+      sums.Means[k] += WB / W * m_Delta[k];
+  }
+
+  void EventCumulantAccumulator::Merge(const EventCumulantAccumulator& other)
+  {
+    if (other.m_NumberOfObservables != m_NumberOfObservables
+      || other.m_MaxOrder != m_MaxOrder
+      || other.m_ErrorEstimate != m_ErrorEstimate
+      || other.m_Samples.size() != m_Samples.size()) {
+      printf("**WARNING** EventCumulantAccumulator::Merge: Incompatible accumulators, skipping\n");
+      return;
+    }
+
+    MergeSums(m_Sums, other.m_Sums);
+    for (size_t i = 0; i < m_Samples.size(); ++i)
+      MergeSums(m_Samples[i], other.m_Samples[i]);
+    m_NextSample += other.m_NextSample;
+  }
+
+  bool EventCumulantAccumulator::CheckIndices(const std::vector<int>& indices) const
+  {
+    if (static_cast<int>(indices.size()) > m_MaxOrder) {
+      printf("**WARNING** EventCumulantAccumulator: Order %d exceeds the maximum order %d\n", static_cast<int>(indices.size()), m_MaxOrder);
+      return false;
+    }
+    for (size_t i = 0; i < indices.size(); ++i) {
+      if (indices[i] < 0 || indices[i] >= m_NumberOfObservables) {
+        printf("**WARNING** EventCumulantAccumulator: Observable index %d out of range\n", indices[i]);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  double EventCumulantAccumulator::Mean(int i, const MomentSums& sums) const
+  {
+    if (i < 0 || i >= m_NumberOfObservables) {
+      printf("**WARNING** EventCumulantAccumulator: Observable index %d out of range\n", i);
+      return 0.;
+    }
+    return sums.Means[i];
+  }
+
+  double EventCumulantAccumulator::CentralMoment(const std::vector<int>& indices, const MomentSums& sums) const
+  {
+    if (!CheckIndices(indices))
+      return 0.;
+    if (indices.size() == 0)
+      return 1.;
+    if (sums.Moments[0] == 0.)
+      return 0.;
+    std::vector<int> exponents(m_NumberOfObservables, 0);
+    for (size_t i = 0; i < indices.size(); ++i)
+      exponents[indices[i]]++;
+    return sums.Moments[MultiIndex(exponents)] / sums.Moments[0];
+  }
+
+  double EventCumulantAccumulator::Cumulant(const std::vector<int>& indices, const MomentSums& sums) const
+  {
+    if (!CheckIndices(indices))
+      return 0.;
+    int n = indices.size();
+    if (n == 0)
+      return 0.;
+    if (n == 1)
+      return sums.Means[indices[0]];
+    if (sums.Moments[0] == 0.)
+      return 0.;
+
+    // Sum over the set partitions of the indices enumerated as restricted growth strings,
+    // partitions with single-element blocks do not contribute
+    double ret = 0.;
+    std::vector<int> blocks(n, 0), maxblock(n, 0);
+    std::vector<int> exponents(m_NumberOfObservables);
+    while (true) {
+      int nblocks = maxblock[n - 1] + 1;
+      std::vector<int> sizes(nblocks, 0);
+      for (int i = 0; i < n; ++i)
+        sizes[blocks[i]]++;
+      bool singletons = false;
+      for (int b = 0; b < nblocks; ++b)
+        singletons |= (sizes[b] == 1);
+
+      if (!singletons) {
+        double term = 1.;
+        for (int b = 0; b < nblocks; ++b) {
+          exponents.assign(m_NumberOfObservables, 0);
+          for (int i = 0; i < n; ++i)
+            if (blocks[i] == b)
+              exponents[indices[i]]++;
+          term *= sums.Moments[MultiIndex(exponents)] / sums.Moments[0];
+        }
+        // (-1)^(nblocks-1) (nblocks-1)!
+        for (int b = 1; b < nblocks; ++b)
+          term *= -b;
+        ret += term;
+      }
+
+      // Next restricted growth string
+      int i = n - 1;
+      while (i > 0 && blocks[i] > maxblock[i - 1])
+        --i;
+      if (i == 0)
+        break;
+      blocks[i]++;
+      maxblock[i] = std::max(maxblock[i - 1], blocks[i]);
+      for (int j = i + 1; j < n; ++j) {
+        blocks[j] = 0;
+        maxblock[j] = maxblock[i];
+      }
+    }
+    return ret;
+  }
+
+  double EventCumulantAccumulator::SampleError(const std::vector<double>& values) const
+  {
+    int nsamples = values.size();
+    if (nsamples < 2)
+      return 0.;
+    double mean = 0.;
+    for (int i = 0; i < nsamples; ++i)
+      mean += values[i];
+    mean /= nsamples;
+    double var = 0.;
+    for (int i = 0; i < nsamples; ++i)
+      var += (values[i] - mean) * (values[i] - mean);
+    var /= (nsamples - 1);
+    // Each subsample contains 1/nsamples of all events
+    if (m_ErrorEstimate == Subsampling)
+      var /= nsamples;
+    return sqrt(var);
+  }
+
+  double EventCumulantAccumulator::CumulantError(const std::vector<int>& indices) const
+  {
+    if (m_Samples.size() == 0) {
+      printf("**WARNING** EventCumulantAccumulator::CumulantError: No subsamples for the error estimate\n");
+      return 0.;
+    }
+    if (!CheckIndices(indices))
+      return 0.;
+    std::vector<double> values(m_Samples.size());
+    for (size_t i = 0; i < m_Samples.size(); ++i)
+      values[i] = Cumulant(indices, m_Samples[i]);
+    return SampleError(values);
+  }
+
+  double EventCumulantAccumulator::CumulantRatioError(const std::vector<int>& numerator, const std::vector<int>& denominator) const
+  {
+    if (m_Samples.size() == 0) {
+      printf("**WARNING** EventCumulantAccumulator::CumulantRatioError: No subsamples for the error estimate\n");
+      return 0.;
+    }
+    if (!CheckIndices(numerator) || !CheckIndices(denominator))
+      return 0.;
+    // Subsamples with a vanishing denominator (e.g. empty or low-statistics ones) are skipped
+    std::vector<double> values;
+    values.reserve(m_Samples.size());
+    int nskipped = 0;
+    for (size_t i = 0; i < m_Samples.size(); ++i) {
+      double denom = Cumulant(denominator, m_Samples[i]);
+      if (denom == 0.) {
+        nskipped++;
+        continue;
+      }
+      values.push_back(Cumulant(numerator, m_Samples[i]) / denom);
+    }
+    if (nskipped > 0)
+      printf("**WARNING** EventCumulantAccumulator::CumulantRatioError: Skipped %d of %d subsamples with a zero denominator\n", nskipped, static_cast<int>(m_Samples.size()));
+    return SampleError(values);
+  }
+
+} // namespace thermalfist
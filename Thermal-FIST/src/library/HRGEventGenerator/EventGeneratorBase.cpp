@@ -24,9 +24,6 @@
 
 namespace thermalfist {
 
-  int EventGeneratorBase::fCEAccepted, EventGeneratorBase::fCETotal;
-  double EventGeneratorBase::m_LastWeight = 1., EventGeneratorBase::m_LastLogWeight = 0., EventGeneratorBase::m_LastNormWeight = 1.;
-
   std::vector<double> LorentzBoost(const std::vector<double>& fourvector, double vx, double vy, double vz)
   {
     std::vector<double> ret(4, 0);
@@ -57,9 +54,15 @@ namespace thermalfist {
     m_MeanSM(0.), m_MeanASM(0.),
     m_MeanCM(0.), m_MeanACM(0.),
     m_MeanCHRM(0.), m_MeanACHRM(0.),
-    m_MeanCHRMM(0.), m_MeanACHRMM(0.)
+    m_MeanCHRMM(0.), m_MeanACHRMM(0.),
+    m_SkellamLogMaxB(0.), m_SkellamLogMaxS(0.),
+    m_SkellamLogMaxQ(0.), m_SkellamLogMaxC(0.),
+    m_AcceptanceFilter(NULL)
   {
-    fCEAccepted = fCETotal = 0; 
+    fCEAccepted = fCETotal = 0;
+    m_LastWeight = 1.;
+    m_LastLogWeight = 0.;
+    m_LastNormWeight = 1.;
   }
 
   EventGeneratorBase::~EventGeneratorBase()
@@ -281,7 +284,7 @@ namespace thermalfist {
     if (m_Config.fEnsemble != EventGeneratorConfiguration::GCE)
       PrepareMultinomials();
 
-    m_Radii = ComputeEVRadii();
+    m_Radii = EVRadiiTable(ComputeEVRadii());
   }
 
 
@@ -381,6 +384,12 @@ namespace thermalfist {
     for (int i = 1; i < static_cast<int>(m_AntiCharmMesons.size()); ++i)    m_AntiCharmMesons[i].first += m_AntiCharmMesons[i - 1].first;
     for (int i = 1; i < static_cast<int>(m_CharmAll.size()); ++i)           m_CharmAll[i].first += m_CharmAll[i - 1].first;
     for (int i = 1; i < static_cast<int>(m_AntiCharmAll.size()); ++i)       m_AntiCharmAll[i].first += m_AntiCharmAll[i - 1].first;
+
+    // Maxima of the Skellam distributions for the conditional sampling in the CE
+    m_SkellamLogMaxB = RandomGenerators::SkellamLogProbability(RandomGenerators::SkellamMode(m_MeanB, m_MeanAB), m_MeanB, m_MeanAB);
+    m_SkellamLogMaxS = RandomGenerators::SkellamLogProbability(RandomGenerators::SkellamMode(m_MeanASM, m_MeanSM), m_MeanASM, m_MeanSM);
+    m_SkellamLogMaxQ = RandomGenerators::SkellamLogProbability(RandomGenerators::SkellamMode(m_MeanACM, m_MeanCM), m_MeanACM, m_MeanCM);
+    m_SkellamLogMaxC = RandomGenerators::SkellamLogProbability(RandomGenerators::SkellamMode(m_MeanACHRMM, m_MeanCHRMM), m_MeanACHRMM, m_MeanCHRMM);
   }
 
   std::vector<int> EventGeneratorBase::GenerateTotals() const {
@@ -460,10 +469,8 @@ namespace thermalfist {
         std::vector<int> totalsaux = GenerateTotalsSCESubVolume(m_THM->CanonicalVolume());
         double prob = m_THM->Volume() / m_THM->CanonicalVolume();
         for (size_t i = 0; i < totalsaux.size(); ++i) {
-          for (int j = 0; j < totalsaux[i]; ++j) {
-            if (RandomGenerators::randgenMT.rand() < prob)
-              totals[i]++;
-          }
+          if (m_THM->TPS()->Particles()[i].Strangeness() != 0)
+            totals[i] = RandomGenerators::RandomBinomial(totalsaux[i], prob);
         }
       }
       // If V > Vc then generate yields from (int)(V/Vc) SCE ensembles
@@ -482,69 +489,7 @@ namespace thermalfist {
         double fraction = (m_THM->Volume() - multiples * m_THM->CanonicalVolume()) / m_THM->CanonicalVolume();
 
         if (fraction > 0.0) {
-
-          bool successflag = false;
-
-          while (!successflag) {
-
-            std::vector<int> totalsaux = GenerateTotalsSCESubVolume(m_THM->CanonicalVolume());
-            std::vector<int> totalsaux2(m_THM->TPS()->Particles().size(), 0);
-            int netS = 0;
-            for (size_t i = 0; i < totalsaux.size(); ++i) {
-              if (m_THM->TPS()->Particles()[i].Strangeness() > 0) {
-                for (int j = 0; j < totalsaux[i]; ++j) {
-                  if (RandomGenerators::randgenMT.rand() < fraction) {
-                    totalsaux2[i]++;
-                    netS += m_THM->TPS()->Particles()[i].Strangeness();
-                  }
-                }
-              }
-            }
-
-            // Check if possible to match S+ with S-
-            // If S = 1 then must be at least one S = -1 hadron
-            if (netS == 1) {
-              bool fl = false;
-              for (size_t i = 0; i < totalsaux.size(); ++i) {
-                if (m_THM->TPS()->Particles()[i].Strangeness() < 0 && totalsaux[i] > 0) {
-                  fl = true;
-                  break;
-                }
-              }
-              if (!fl) {
-                printf("**WARNING** SCE Event generator: Cannot match S- with S+ = 1, discarding subconfiguration...\n");
-                continue;
-              }
-            }
-
-            int repeatmax = 10000;
-            int repeat = 0;
-            while (true) {
-              int netS2 = netS;
-              for (size_t i = 0; i < totalsaux.size(); ++i) {
-                if (m_THM->TPS()->Particles()[i].Strangeness() < 0) {
-                  totalsaux2[i] = 0;
-                  for (int j = 0; j < totalsaux[i]; ++j) {
-                    if (RandomGenerators::randgenMT.rand() < fraction) {
-                      totalsaux2[i]++;
-                      netS2 += m_THM->TPS()->Particles()[i].Strangeness();
-                    }
-                  }
-                }
-              }
-              if (netS2 == 0) {
-                for (size_t i = 0; i < totalsaux2.size(); ++i)
-                  totals[i] += totalsaux2[i];
-                successflag = true;
-                break;
-              }
-              repeat++;
-              if (repeat >= repeatmax) {
-                printf("**WARNING** SCE event generator: Cannot match S- with S+, too many tries, discarding configuration...\n");
-                break;
-              }
-            }
-          }
+          while (!SampleSCEFractionalSubVolume(fraction, totals)) { }
         }
       }
 
@@ -562,24 +507,151 @@ namespace thermalfist {
     return totals;
   }
 
+  bool EventGeneratorBase::SampleSCEFractionalSubVolume(double fraction, std::vector<int>& totals) const
+  {
+    const ThermalParticleSystem* TPS = m_THM->TPS();
+    std::vector<int> totalsaux = GenerateTotalsSCESubVolume(m_THM->CanonicalVolume());
+    std::vector<int> totalssub(totalsaux.size(), 0);
+
+    // Hadrons with S > 0 are selected independently
+    int netS = 0;
+    for (size_t i = 0; i < totalsaux.size(); ++i) {
+      if (TPS->Particles()[i].Strangeness() > 0 && totalsaux[i] > 0) {
+        totalssub[i] = RandomGenerators::RandomBinomial(totalsaux[i], fraction);
+        netS += totalssub[i] * TPS->Particles()[i].Strangeness();
+      }
+    }
+
+    // Hadrons with S < 0 are grouped by |S|, groups with larger |S| first
+    std::vector<int> groupS, groupN;
+    for (size_t i = 0; i < totalsaux.size(); ++i) {
+      int S = -TPS->Particles()[i].Strangeness();
+      if (S > 0 && totalsaux[i] > 0) {
+        size_t ig = 0;
+        while (ig < groupS.size() && groupS[ig] != S)
+          ig++;
+        if (ig == groupS.size()) {
+          groupS.push_back(S);
+          groupN.push_back(0);
+        }
+        groupN[ig] += totalsaux[i];
+      }
+    }
+    for (size_t ig = 1; ig < groupS.size(); ++ig) {
+      for (size_t jg = ig; jg > 0 && groupS[jg - 1] < groupS[jg]; --jg) {
+        std::swap(groupS[jg - 1], groupS[jg]);
+        std::swap(groupN[jg - 1], groupN[jg]);
+      }
+    }
+    int Ngroups = groupS.size();
+
+    if (Ngroups == 0) {
+      if (netS != 0)
+        return false;
+      for (size_t i = 0; i < totalssub.size(); ++i)
+        totals[i] += totalssub[i];
+      return true;
+    }
+
+    // Binomial probabilities (up to a normalization) of selecting K hadrons in each group
+    std::vector< std::vector<double> > binomial(Ngroups);
+    for (int ig = 0; ig < Ngroups; ++ig) {
+      int Kmax = std::min(groupN[ig], netS / groupS[ig]);
+      binomial[ig].resize(Kmax + 1);
+      double logmax = -1.e100;
+      for (int K = 0; K <= Kmax; ++K) {
+        double logp = -xMath::LogGamma(K + 1.) - xMath::LogGamma(groupN[ig] - K + 1.);
+        if (fraction < 1.)
+          logp += K * log(fraction) + (groupN[ig] - K) * log(1. - fraction);
+        else if (K < groupN[ig])
+          logp = -1.e100;
+        binomial[ig][K] = logp;
+        logmax = std::max(logmax, logp);
+      }
+      for (int K = 0; K <= Kmax; ++K)
+        binomial[ig][K] = exp(binomial[ig][K] - logmax);
+    }
+
+    // weights[ig][t] is the probability that the groups 0..ig carry the strangeness t
+    // The last group is evaluated at t = netS only
+    std::vector< std::vector<double> > weights(Ngroups, std::vector<double>(netS + 1, 0.));
+    for (int t = 0; t <= netS; ++t) {
+      if (t % groupS[0] == 0 && t / groupS[0] < static_cast<int>(binomial[0].size()))
+        weights[0][t] = binomial[0][t / groupS[0]];
+    }
+    for (int ig = 1; ig < Ngroups; ++ig) {
+      int tmin = (ig == Ngroups - 1) ? netS : 0;
+      for (int t = tmin; t <= netS; ++t) {
+        double w = 0.;
+        for (int K = 0; K < static_cast<int>(binomial[ig].size()) && K * groupS[ig] <= t; ++K)
+          w += binomial[ig][K] * weights[ig - 1][t - K * groupS[ig]];
+        weights[ig][t] = w;
+      }
+    }
+
+    if (!(weights[Ngroups - 1][netS] > 0.))
+      return false;
+
+    // Sample the number of selected hadrons in each group, starting from the last one
+    std::vector<int> groupK(Ngroups, 0);
+    int t = netS;
+    for (int ig = Ngroups - 1; ig >= 0; --ig) {
+      if (ig == 0) {
+        groupK[ig] = t / groupS[ig];
+        break;
+      }
+      double u = RandomGenerators::randgenMT.rand() * weights[ig][t];
+      int K = 0;
+      for (; K < static_cast<int>(binomial[ig].size()) && K * groupS[ig] <= t; ++K) {
+        u -= binomial[ig][K] * weights[ig - 1][t - K * groupS[ig]];
+        if (u <= 0.)
+          break;
+      }
+      // Round-off safety
+      while (K * groupS[ig] > t || K >= static_cast<int>(binomial[ig].size()) || weights[ig - 1][t - K * groupS[ig]] == 0.)
+        K--;
+      groupK[ig] = K;
+      t -= K * groupS[ig];
+    }
+
+    // Distribute the selected hadrons among the species in each group
+    std::vector<int> groupLeft = groupN;
+    for (size_t i = 0; i < totalsaux.size(); ++i) {
+      int S = -TPS->Particles()[i].Strangeness();
+      if (S > 0 && totalsaux[i] > 0) {
+        int ig = 0;
+        while (groupS[ig] != S)
+          ig++;
+        int k = RandomGenerators::RandomHypergeometric(groupK[ig], totalsaux[i], groupLeft[ig]);
+        totalssub[i] = k;
+        groupK[ig] -= k;
+        groupLeft[ig] -= totalsaux[i];
+      }
+    }
+
+    for (size_t i = 0; i < totalssub.size(); ++i)
+      totals[i] += totalssub[i];
+
+    return true;
+  }
+
   std::vector<int> EventGeneratorBase::GenerateTotalsSCESubVolume(double VolumeSC) const
   {
     if (!m_THM->IsCalculated())
       m_THM->CalculatePrimordialDensities();
     std::vector<int> totals(m_THM->TPS()->Particles().size(), 0);
 
-    std::vector< std::pair<double, int> > fStrangeMesonsc = m_StrangeMesons;
-    std::vector< std::pair<double, int> > fAntiStrangeMesonsc = m_AntiStrangeMesons;
-
-    for (size_t i = 0; i < fStrangeMesonsc.size(); ++i)
-      fStrangeMesonsc[i].first *= VolumeSC / m_THM->Volume();
-
-    for (size_t i = 0; i < fAntiStrangeMesonsc.size(); ++i)
-      fAntiStrangeMesonsc[i].first *= VolumeSC / m_THM->Volume();
+    // The relative weights of the species do not depend on the volume
+    const std::vector< std::pair<double, int> >& fStrangeMesonsc = m_StrangeMesons;
+    const std::vector< std::pair<double, int> >& fAntiStrangeMesonsc = m_AntiStrangeMesons;
 
     double fMeanSMc = m_MeanSM * VolumeSC / m_THM->Volume();
     double fMeanASMc = m_MeanASM * VolumeSC / m_THM->Volume();
 
+    double logPmaxS = 0.;
+    if (m_Config.fUseCEConditionalSampling)
+      logPmaxS = RandomGenerators::SkellamLogProbability(RandomGenerators::SkellamMode(fMeanASMc, fMeanSMc), fMeanASMc, fMeanSMc);
+
     while (1) {
       fCETotal++;
       const std::vector<double>& densities = m_THM->Densities();
@@ -594,20 +666,26 @@ namespace thermalfist {
           netS += totals[i] * m_THM->TPS()->Particles()[i].Strangeness();
         }
       }
-      int tSM = RandomGenerators::RandomPoisson(fMeanSMc);
-      int tASM = RandomGenerators::RandomPoisson(fMeanASMc);
-
-      if (netS != tASM - tSM) continue;
+      int tSM = 0, tASM = 0;
+      if (m_Config.fUseCEConditionalSampling) {
+        if (!SampleConditionalTotals(netS, fMeanASMc, fMeanSMc, logPmaxS, tASM, tSM))
+          continue;
+      }
+      else {
+        tSM = RandomGenerators::RandomPoisson(fMeanSMc);
+        tASM = RandomGenerators::RandomPoisson(fMeanASMc);
+        if (netS != tASM - tSM) continue;
+      }
 
       for (int i = 0; i < tSM; ++i) {
-        std::vector< std::pair<double, int> >::iterator it = lower_bound(fStrangeMesonsc.begin(), fStrangeMesonsc.end(), std::make_pair(fMeanSMc*RandomGenerators::randgenMT.rand(), 0));
+        std::vector< std::pair<double, int> >::const_iterator it = lower_bound(fStrangeMesonsc.begin(), fStrangeMesonsc.end(), std::make_pair(m_MeanSM*RandomGenerators::randgenMT.rand(), 0));
         int tind = std::distance(fStrangeMesonsc.begin(), it);
         if (tind < 0) tind = 0;
         if (tind >= static_cast<int>(fStrangeMesonsc.size())) tind = fStrangeMesonsc.size() - 1;
         totals[fStrangeMesonsc[tind].second]++;
       }
       for (int i = 0; i < tASM; ++i) {
-        std::vector< std::pair<double, int> >::iterator it = lower_bound(fAntiStrangeMesonsc.begin(), fAntiStrangeMesonsc.end(), std::make_pair(fMeanASMc*RandomGenerators::randgenMT.rand(), 0));
+        std::vector< std::pair<double, int> >::const_iterator it = lower_bound(fAntiStrangeMesonsc.begin(), fAntiStrangeMesonsc.end(), std::make_pair(m_MeanASM*RandomGenerators::randgenMT.rand(), 0));
         int tind = std::distance(fAntiStrangeMesonsc.begin(), it);
         if (tind < 0) tind = 0;
         if (tind >= static_cast<int>(fAntiStrangeMesonsc.size())) tind = fAntiStrangeMesonsc.size() - 1;
@@ -955,7 +1033,11 @@ namespace thermalfist {
 
       int tB = 0, tAB = 0;
       // First total baryons and antibaryons from the Poisson distribution
-      if (flNuclei || !m_Config.CanonicalB) {
+      if (flNuclei && m_Config.CanonicalB && m_Config.fUseCEConditionalSampling) {
+        if (!SampleConditionalTotals(m_Config.B - netB, m_MeanB, m_MeanAB, m_SkellamLogMaxB, tB, tAB))
+          continue;
+      }
+      else if (flNuclei || !m_Config.CanonicalB) {
         tB = RandomGenerators::RandomPoisson(m_MeanB);
         tAB = RandomGenerators::RandomPoisson(m_MeanAB);
         if (m_Config.CanonicalB && tB - tAB != m_Config.B - netB) continue;
@@ -1006,9 +1088,16 @@ namespace thermalfist {
 
       // Total numbers of (anti)strange mesons
       
-      int tSM = RandomGenerators::RandomPoisson(m_MeanSM);
-      int tASM = RandomGenerators::RandomPoisson(m_MeanASM);
-      if (m_Config.CanonicalS && netS != tASM - tSM + m_Config.S) continue;
+      int tSM = 0, tASM = 0;
+      if (m_Config.CanonicalS && m_Config.fUseCEConditionalSampling) {
+        if (!SampleConditionalTotals(netS - m_Config.S, m_MeanASM, m_MeanSM, m_SkellamLogMaxS, tASM, tSM))
+          continue;
+      }
+      else {
+        tSM = RandomGenerators::RandomPoisson(m_MeanSM);
+        tASM = RandomGenerators::RandomPoisson(m_MeanASM);
+        if (m_Config.CanonicalS && netS != tASM - tSM + m_Config.S) continue;
+      }
 
 
       // Multinomial distribution for individual numbers of (anti)strange mesons
@@ -1032,9 +1121,16 @@ namespace thermalfist {
       }
 
       // Total numbers of remaining electrically charged mesons
-      int tCM = RandomGenerators::RandomPoisson(m_MeanCM);
-      int tACM = RandomGenerators::RandomPoisson(m_MeanACM);
-      if (m_Config.CanonicalQ && netQ != tACM - tCM + m_Config.Q) continue;
+      int tCM = 0, tACM = 0;
+      if (m_Config.CanonicalQ && m_Config.fUseCEConditionalSampling) {
+        if (!SampleConditionalTotals(netQ - m_Config.Q, m_MeanACM, m_MeanCM, m_SkellamLogMaxQ, tACM, tCM))
+          continue;
+      }
+      else {
+        tCM = RandomGenerators::RandomPoisson(m_MeanCM);
+        tACM = RandomGenerators::RandomPoisson(m_MeanACM);
+        if (m_Config.CanonicalQ && netQ != tACM - tCM + m_Config.Q) continue;
+      }
 
       // Multinomial distribution for individual numbers of remaining electrically charged mesons
       for (int i = 0; i < tCM; ++i) {
@@ -1055,10 +1151,16 @@ namespace thermalfist {
       }
 
       // Total numbers of remaining charmed mesons
-      int tCHRMM = RandomGenerators::RandomPoisson(m_MeanCHRMM);
-      int tACHRNMM = RandomGenerators::RandomPoisson(m_MeanACHRMM);
-
-      if (m_Config.CanonicalC && netC != tACHRNMM - tCHRMM + m_Config.C) continue;
+      int tCHRMM = 0, tACHRNMM = 0;
+      if (m_Config.CanonicalC && m_Config.fUseCEConditionalSampling) {
+        if (!SampleConditionalTotals(netC - m_Config.C, m_MeanACHRMM, m_MeanCHRMM, m_SkellamLogMaxC, tACHRNMM, tCHRMM))
+          continue;
+      }
+      else {
+        tCHRMM = RandomGenerators::RandomPoisson(m_MeanCHRMM);
+        tACHRNMM = RandomGenerators::RandomPoisson(m_MeanACHRMM);
+        if (m_Config.CanonicalC && netC != tACHRNMM - tCHRMM + m_Config.C) continue;
+      }
 
       // Multinomial distribution for individual numbers of the remaining charmed mesons
       for (int i = 0; i < tCHRMM; ++i) {
@@ -1122,6 +1224,96 @@ namespace thermalfist {
     return totals;
   }
 
+  bool EventGeneratorBase::SampleConditionalTotals(int d, double mu1, double mu2, double logPmax, int& n1, int& n2)
+  {
+    n1 = n2 = 0;
+
+    // Acceptance of the required difference relative to the most probable one
+    double logP = RandomGenerators::SkellamLogProbability(d, mu1, mu2);
+    if (RandomGenerators::randgenMT.rand() >= exp(logP - logPmax))
+      return false;
+
+    int nu = (d < 0) ? -d : d;
+    double a = 2. * sqrt(mu1 * mu2);
+    int BessN = 0;
+    if (a > 0.)
+      BessN = RandomGenerators::BesselDistributionGenerator::RandomBesselDevroye1(a, nu);
+    if (d < 0) {
+      n1 = BessN;
+      n2 = nu + n1;
+    }
+    else {
+      n2 = BessN;
+      n1 = nu + n2;
+    }
+    return true;
+  }
+
+  namespace {
+    // Whether the species or any of its descendants can be accepted by the filter
+    // state: -1 - not yet computed, 0 - no, 1 - yes
+    bool IsAcceptanceRelevant(const ThermalParticleSystem* TPS, const Acceptance::AcceptanceFilter* filter, int id, std::vector<int>& state)
+    {
+      if (state[id] != -1)
+        return (state[id] == 1);
+
+      const ThermalParticle& species = TPS->Particles()[id];
+      state[id] = filter->ContainsSpecies(species.PdgId()) ? 1 : 0;
+      if (state[id] == 0 && !species.IsStable()) {
+        for (size_t idec = 0; idec < species.Decays().size() && state[id] == 0; ++idec) {
+          const std::vector<long long>& daughters = species.Decays()[idec].mDaughters;
+          for (size_t di = 0; di < daughters.size(); ++di) {
+            int did = TPS->PdgToId(daughters[di]);
+            if (did != -1 && did != id && IsAcceptanceRelevant(TPS, filter, did, state)) {
+              state[id] = 1;
+              break;
+            }
+          }
+        }
+      }
+
+      return (state[id] == 1);
+    }
+  }
+
+  void EventGeneratorBase::SetAcceptanceFilter(const Acceptance::AcceptanceFilter* filter)
+  {
+    m_AcceptanceFilter = filter;
+    m_AcceptanceRelevant.clear();
+    if (m_AcceptanceFilter == NULL)
+      return;
+
+    if (m_THM == NULL) {
+      printf("**WARNING** EventGeneratorBase::SetAcceptanceFilter(): The event generator is not configured, all the primordial particles will be sampled\n");
+      return;
+    }
+
+    const ThermalParticleSystem* TPS = m_THM->TPS();
+    std::vector<int> state(TPS->Particles().size(), -1);
+    m_AcceptanceRelevant.resize(TPS->Particles().size());
+    for (size_t i = 0; i < TPS->Particles().size(); ++i)
+      m_AcceptanceRelevant[i] = IsAcceptanceRelevant(TPS, m_AcceptanceFilter, i, state);
+  }
+
+  void EventGeneratorBase::ApplyAcceptanceFilter(SimpleEvent& evt) const
+  {
+    if (m_AcceptanceFilter == NULL)
+      return;
+
+    size_t accepted = 0;
+    for (size_t i = 0; i < evt.Particles.size(); ++i) {
+      if (m_AcceptanceFilter->Accept(evt.Particles[i])) {
+        evt.Particles[accepted] = evt.Particles[i];
+        if (i < evt.DecayMapFinal.size())
+          evt.DecayMapFinal[accepted] = evt.DecayMapFinal[i];
+        accepted++;
+      }
+    }
+    evt.Particles.resize(accepted);
+    if (evt.DecayMapFinal.size() > accepted)
+      evt.DecayMapFinal.resize(accepted);
+  }
+
   std::pair<std::vector<int>, double> EventGeneratorBase::SampleYields() const
   {
     std::vector<int> totals = GenerateTotals();
@@ -1204,33 +1396,47 @@ namespace thermalfist {
 
     SimpleEvent ret;
 
+    bool checkOverlaps = m_Config.fUseEVRejectionCoordinates &&
+      (m_Config.fModelType == EventGeneratorConfiguration::DiagonalEV
+      || m_Config.fModelType == EventGeneratorConfiguration::CrosstermsEV
+      || m_Config.fModelType == EventGeneratorConfiguration::QvdW);
+
+    // Particles which cannot end up in the acceptance are not sampled,
+    // unless they are needed for the excluded-volume overlap checks
+    bool skipIrrelevant = (m_AcceptanceFilter != NULL && !checkOverlaps
+      && m_AcceptanceRelevant.size() == m_THM->TPS()->Particles().size());
+
     std::vector<int> ids;
-    for (int i = 0; i < m_THM->TPS()->Particles().size(); ++i)
+    for (int i = 0; i < m_THM->TPS()->Particles().size(); ++i) {
+      if (skipIrrelevant && !m_AcceptanceRelevant[i])
+        continue;
       for (int part = 0; part < yields[i]; ++part)
         ids.push_back(i);
-    std::random_shuffle(ids.begin(), ids.end());
+    }
+    // Fisher-Yates shuffle with randgenMT, such that the events are fully determined by its seed
+    for (int i = static_cast<int>(ids.size()) - 1; i > 0; --i)
+      std::swap(ids[i], ids[RandomGenerators::randgenMT.randInt(i)]);
 
     ret.Particles.resize(ids.size());
 
+    EVOverlapIndex overlapIndex;
+    if (checkOverlaps)
+      overlapIndex.SetRadiiTable(&m_Radii);
+
     bool flOverlap = true;
     while (flOverlap) {
+      // Empty events are accepted right away
+      flOverlap = false;
       int sampled = 0;
+      if (checkOverlaps)
+        overlapIndex.Clear(ids.size());
       while (sampled < ids.size()) {
         flOverlap = false;
         int i = ids[sampled];
-        const ThermalParticle& species = m_THM->TPS()->Particles()[i];
         SimpleParticle cand = SampleParticle(i);
 
-        if (m_Config.fUseEVRejectionCoordinates && 
-          (m_Config.fModelType == EventGeneratorConfiguration::DiagonalEV
-          || m_Config.fModelType == EventGeneratorConfiguration::CrosstermsEV
-          || m_Config.fModelType == EventGeneratorConfiguration::QvdW)) {
-          for (int i = 0; i < sampled; ++i) {
-            double r = m_Radii[ids[i]][ids[sampled]];
-            if (r != 0.0) {
-              flOverlap |= (ParticleDecaysMC::ParticleDistanceSquared(ret.Particles[i], cand) <= 4. * r * r);
-            }
-          }
+        if (checkOverlaps) {
+          flOverlap = overlapIndex.CheckOverlap(cand, i);
 
           if (flOverlap) {
             if (EVUseSPR()) {
@@ -1243,6 +1449,8 @@ namespace thermalfist {
         }
 
         ret.Particles[sampled] = cand;
+        if (checkOverlaps)
+          overlapIndex.Insert(cand, i);
         sampled++;
       }
     }
@@ -1287,9 +1495,10 @@ namespace thermalfist {
     ret.weight = m_LastNormWeight;
 
     if (DoDecays)
-      return PerformDecays(ret, m_THM->TPS());
-    else
-      return ret;
+      return PerformDecays(ret, m_THM->TPS(), m_AcceptanceFilter);
+
+    ApplyAcceptanceFilter(ret);
+    return ret;
   }
 
   // SimpleEvent EventGeneratorBase::PerformDecaysAlternativeWay(const SimpleEvent& evtin, ThermalParticleSystem* TPS)
@@ -1387,7 +1596,7 @@ namespace thermalfist {
   //   return ret;
   // }
 
-  SimpleEvent EventGeneratorBase::PerformDecays(const SimpleEvent& evtin, const ThermalParticleSystem* TPS)
+  SimpleEvent EventGeneratorBase::PerformDecays(const SimpleEvent& evtin, const ThermalParticleSystem* TPS, const Acceptance::AcceptanceFilter* filter)
   {
     SimpleEvent ret;
     ret.weight = evtin.weight;
@@ -1407,6 +1616,11 @@ namespace thermalfist {
       }
     }
 
+    // Buffers reused across the decays
+    std::vector<double> masses;
+    std::vector<long long> pdgids;
+    std::vector<SimpleParticle> decres;
+
     bool flag_repeat = true;
     while (flag_repeat) {
       flag_repeat = false;
@@ -1414,9 +1628,10 @@ namespace thermalfist {
         if (TPS->Particles()[i].IsStable()) {
           for (size_t j = 0; j < primParticles[i].size(); ++j) {
             if (!primParticles[i][j].processed) {
-              SimpleParticle prt = primParticles[i][j];
-              ret.Particles.push_back(prt);
               primParticles[i][j].processed = true;
+              if (filter != NULL && !filter->Accept(primParticles[i][j]))
+                continue;
+              ret.Particles.push_back(primParticles[i][j]);
               int tid = AllParticlesMap[i][j];
               while (tid >= 0 && tid < ret.DecayMap.size() && ret.DecayMap[tid] != -1)
                 tid = ret.DecayMap[tid];
@@ -1445,8 +1660,8 @@ namespace thermalfist {
                 if (tsum > DecParam) break;
               }
               if (DecayIndex < static_cast<int>(TPS->Particles()[i].Decays().size())) {
-                std::vector<double> masses(0);
-                std::vector<long long> pdgids(0);
+                masses.clear();
+                pdgids.clear();
                 for (size_t di = 0; di < TPS->Particles()[i].Decays()[DecayIndex].mDaughters.size(); di++) {
                   long long dpdg = TPS->Particles()[i].Decays()[DecayIndex].mDaughters[di];
                   if (TPS->PdgToId(dpdg) == -1) {
@@ -1461,7 +1676,7 @@ namespace thermalfist {
                   }
                   pdgids.push_back(dpdg);
                 }
-                std::vector<SimpleParticle> decres = ParticleDecaysMC::ManyBodyDecay(primParticles[i][j], masses, pdgids);
+                ParticleDecaysMC::ManyBodyDecay(primParticles[i][j], masses, pdgids, decres);
                 for (size_t ind = 0; ind < decres.size(); ind++) {
                   decres[ind].processed = false;
                   if (TPS->PdgToId(decres[ind].PDGID) != -1) {
@@ -1880,6 +2095,7 @@ namespace thermalfist {
     fUseEVRejectionMultiplicity = true;
     fUseEVRejectionCoordinates = true;
     fUseEVUseSPRApproximation = true;
+    fUseCEConditionalSampling = false;
   }
 
 } // namespace thermalfist
\ No newline at end of file
@@ -113,4 +113,100 @@ namespace thermalfist {
     return Rmax() * zeta * m_tauH * Rmax();
   }
 
+  BoostInvariantFreezeoutTable::BoostInvariantFreezeoutTable(const BoostInvariantFreezeoutParametrization& model, int nzeta) :
+    m_Nzeta(nzeta)
+  {
+    if (m_Nzeta < 1)
+      m_Nzeta = 1;
+    m_dZeta = 1. / m_Nzeta;
+
+    m_Points.resize(m_Nzeta + 1);
+    m_PDF.resize(m_Nzeta + 1);
+    m_CDF.resize(m_Nzeta + 1);
+    for (int i = 0; i <= m_Nzeta; ++i) {
+      double zeta = i * m_dZeta;
+      Point& pt = m_Points[i];
+      pt.R = model.Rfunc(zeta);
+      pt.dRdZeta = model.dRdZeta(zeta);
+      pt.tau = model.taufunc(zeta);
+      pt.dtaudZeta = model.dtaudZeta(zeta);
+      pt.sinhetaperp = model.sinhetaperp(zeta);
+      pt.coshetaperp = model.coshetaperp(zeta);
+      pt.tanhetaperp = model.tanhetaperp(zeta);
+      m_PDF[i] = model.ZetaProbability(zeta);
+    }
+
+    m_CDF[0] = 0.;
+    for (int i = 0; i < m_Nzeta; ++i)
+      m_CDF[i + 1] = m_CDF[i] + 0.5 * (m_PDF[i] + m_PDF[i + 1]) * m_dZeta;
+
+    double norm = m_CDF[m_Nzeta];
+    if (!(norm > 0.)) {
+      std::cerr << "**ERROR** BoostInvariantFreezeoutTable: The zeta distribution is not normalizable!" << std::endl;
+      exit(1);
+    }
+    for (int i = 0; i <= m_Nzeta; ++i) {
+      m_PDF[i] /= norm;
+      m_CDF[i] /= norm;
+    }
+    m_CDF[m_Nzeta] = 1.;
+
+    m_Guide.resize(m_Nzeta);
+    int icell = 0;
+    for (int k = 0; k < m_Nzeta; ++k) {
+      double xi = k * m_dZeta;
+      while (icell < m_Nzeta - 1 && m_CDF[icell + 1] <= xi)
+        icell++;
+      m_Guide[k] = icell;
+    }
+  }
+
+  BoostInvariantFreezeoutTable::Point BoostInvariantFreezeoutTable::Interpolate(double zeta) const
+  {
+    double x = zeta * m_Nzeta;
+    int i = static_cast<int>(x);
+    if (i < 0)
+      i = 0;
+    if (i >= m_Nzeta)
+      i = m_Nzeta - 1;
+    double t = x - i;
+
+    const Point& p1 = m_Points[i];
+    const Point& p2 = m_Points[i + 1];
+    Point ret;
+    ret.R = p1.R + t * (p2.R - p1.R);
+    ret.dRdZeta = p1.dRdZeta + t * (p2.dRdZeta - p1.dRdZeta);
+    ret.tau = p1.tau + t * (p2.tau - p1.tau);
+    ret.dtaudZeta = p1.dtaudZeta + t * (p2.dtaudZeta - p1.dtaudZeta);
+    ret.sinhetaperp = p1.sinhetaperp + t * (p2.sinhetaperp - p1.sinhetaperp);
+    ret.coshetaperp = p1.coshetaperp + t * (p2.coshetaperp - p1.coshetaperp);
+    ret.tanhetaperp = p1.tanhetaperp + t * (p2.tanhetaperp - p1.tanhetaperp);
+    return ret;
+  }
+
+  double BoostInvariantFreezeoutTable::InverseZetaDistribution(double xi) const
+  {
+    int k = static_cast<int>(xi * m_Nzeta);
+    if (k < 0)
+      k = 0;
+    if (k >= m_Nzeta)
+      k = m_Nzeta - 1;
+
+    int i = m_Guide[k];
+    while (i < m_Nzeta - 1 && m_CDF[i + 1] <= xi)
+      i++;
+
+    // Invert the cumulative distribution of the linear density within the cell
+    double area = xi - m_CDF[i];
+    double slope = (m_PDF[i + 1] - m_PDF[i]) / m_dZeta;
+    double disc = m_PDF[i] * m_PDF[i] + 2. * slope * area;
+    if (disc < 0.)
+      disc = 0.;
+    double denom = m_PDF[i] + sqrt(disc);
+    double dz = (denom > 0.) ? 2. * area / denom : 0.;
+    if (dz > m_dZeta)
+      dz = m_dZeta;
+    return i * m_dZeta + dz;
+  }
+
 } // namespace thermalfist
\ No newline at end of file
@@ -7,6 +7,7 @@
  */
 
 #include <iostream>
+#include <algorithm>
 
 #include "HRGEventGenerator/SimpleParticle.h"
 #include "HRGEventGenerator/ParticleDecaysMC.h"
@@ -44,27 +45,88 @@ namespace thermalfist {
 
   void RandomGenerators::VolumeElementSampler::FillProbabilities(const std::vector<double>& Weights)
   {
-    m_CumulativeProbabilities = std::vector<double>(Weights.size(), 0.);
+    int N = Weights.size();
+    m_Probabilities = std::vector<double>(N, 1.);
+    m_Aliases = std::vector<int>(N, 0);
+    for (int i = 0; i < N; ++i)
+      m_Aliases[i] = i;
+
     double totalWeight = 0.;
-    for (int i = 0; i < Weights.size(); ++i) {
-      totalWeight += Weights[i];
-      m_CumulativeProbabilities[i] += Weights[i];
-      if (i > 0)
-        m_CumulativeProbabilities[i] += m_CumulativeProbabilities[i - 1];
+    for (int i = 0; i < N; ++i) {
+      if (Weights[i] > 0.)
+        totalWeight += Weights[i];
     }
-    for (double& prob : m_CumulativeProbabilities) {
-      prob /= totalWeight;
+
+    if (N == 0 || totalWeight <= 0.)
+      return;
+
+    // Vose's alias method
+    std::vector<double> scaled(N, 0.);
+    std::vector<int> small, large;
+    small.reserve(N);
+    large.reserve(N);
+    for (int i = 0; i < N; ++i) {
+      scaled[i] = (Weights[i] > 0. ? Weights[i] : 0.) * N / totalWeight;
+      if (scaled[i] < 1.)
+        small.push_back(i);
+      else
+        large.push_back(i);
+    }
+
+    while (!small.empty() && !large.empty()) {
+      int l = small.back();
+      small.pop_back();
+      int g = large.back();
+      large.pop_back();
+
+      m_Probabilities[l] = scaled[l];
+      m_Aliases[l] = g;
+
+      scaled[g] = (scaled[g] + scaled[l]) - 1.;
+      if (scaled[g] < 1.)
+        small.push_back(g);
+      else
+        large.push_back(g);
     }
+
+    // Whatever remains has probability one up to round-off errors
+    for (size_t i = 0; i < large.size(); ++i)
+      m_Probabilities[large[i]] = 1.;
+    for (size_t i = 0; i < small.size(); ++i)
+      m_Probabilities[small[i]] = 1.;
+  }
+
+  void RandomGenerators::VolumeElementSampler::SetProbabilities(const std::vector<double>& CumulativeProbabilities)
+  {
+    std::vector<double> Weights(CumulativeProbabilities.size(), 0.);
+    for (size_t i = 0; i < CumulativeProbabilities.size(); ++i) {
+      Weights[i] = CumulativeProbabilities[i];
+      if (i > 0)
+        Weights[i] -= CumulativeProbabilities[i - 1];
+    }
+    FillProbabilities(Weights);
   }
 
   int RandomGenerators::VolumeElementSampler::SampleVolumeElement(MTRand& rangen) const
   {
-    double prob = rangen.rand();
-    const auto& it = std::lower_bound(m_CumulativeProbabilities.begin(), m_CumulativeProbabilities.end(), prob);
-    int tind = std::distance(m_CumulativeProbabilities.begin(), it);
-    if (tind < 0) tind = 0;
-    if (tind >= static_cast<int>(m_CumulativeProbabilities.size())) tind = m_CumulativeProbabilities.size() - 1;
-    return tind;
+    if (m_Probabilities.size() == 0)
+      return 0;
+    int tind = rangen.randInt(m_Probabilities.size() - 1);
+    if (rangen.randExc() < m_Probabilities[tind])
+      return tind;
+    return m_Aliases[tind];
+  }
+
+
+  void RandomGenerators::PhaseSpaceCoordinatesBatch::resize(size_t n)
+  {
+    px.resize(n);
+    py.resize(n);
+    pz.resize(n);
+    r0.resize(n);
+    rx.resize(n);
+    ry.resize(n);
+    rz.resize(n);
   }
 
 
@@ -72,11 +134,14 @@ namespace thermalfist {
   (const ParticlizationHypersurface* hypersurface,
     const ThermalParticle* particle,
     const VolumeElementSampler* positionsampler,
-    double etasmear) :
+    double etasmear,
+    int batchsize) :
     m_ParticlizationHypersurface(hypersurface),
     m_Particle(particle),
     m_VolumeElementSampler(positionsampler),
-    m_EtaSmear(etasmear)
+    m_EtaSmear(etasmear),
+    m_BatchSize(batchsize),
+    m_BufferPosition(0)
   {
 
   }
@@ -91,6 +156,19 @@ namespace thermalfist {
     if (mass < 0.)
       mass = Mass();
 
+    // Batch sampling for the pole mass
+    if (m_BatchSize > 1 && mass == Mass()) {
+      if (m_BufferPosition >= m_Buffer.size()) {
+        m_BufferElements.resize(m_BatchSize);
+        for (int i = 0; i < m_BatchSize; ++i)
+          m_BufferElements[i] = m_VolumeElementSampler->SampleVolumeElement();
+        SamplePhaseSpaceCoordinatesFromElements(m_ParticlizationHypersurface, m_BufferElements, m_Particle, m_Buffer, mass, EtaSmear());
+        m_BufferPosition = 0;
+      }
+      size_t i = m_BufferPosition++;
+      return { m_Buffer.px[i], m_Buffer.py[i], m_Buffer.pz[i], m_Buffer.r0[i], m_Buffer.rx[i], m_Buffer.ry[i], m_Buffer.rz[i] };
+    }
+
     int VolumeElementIndex = m_VolumeElementSampler->SampleVolumeElement();
 
     const ParticlizationHypersurfaceElement& elem = (*m_ParticlizationHypersurface)[VolumeElementIndex];
@@ -105,6 +183,8 @@ namespace thermalfist {
     SetHypersurface(hypersurface);
     SetEtaSmear(etasmear);
     SetRescaleTmu();
+    SetSamplerSharingTolerance();
+    SetMomentumBatchSize();
     //SetParameters(hypersurface, m_THM, etasmear);
   }
 
@@ -208,14 +288,7 @@ namespace thermalfist {
       }
     }
 
-    // Free memory just in case
-    std::vector<RandomGenerators::VolumeElementSampler>().swap(m_VolumeElementSamplers);
-    m_VolumeElementSamplers.clear();
-    for (size_t ipart = 0; ipart < m_THM->TPS()->ComponentsNumber(); ++ipart) {
-      m_VolumeElementSamplers.push_back(RandomGenerators::VolumeElementSampler(allweights[ipart]));
-      // Free memory
-      vector<double>().swap(allweights[ipart]);
-    }
+    SetVolumeElementSamplers(allweights);
 
     m_FullSpaceYields = FullDensities;
 
@@ -291,6 +364,69 @@ namespace thermalfist {
       PrepareMultinomials();
   }
 
+  void HypersurfaceEventGenerator::SetVolumeElementSamplers(std::vector< std::vector<double> >& allweights)
+  {
+    const ThermalParticleSystem* TPS = m_THM->TPS();
+    int Nspecies = TPS->ComponentsNumber();
+    int Nelem = m_ParticlizationHypersurface->size();
+
+    // Free memory just in case
+    std::vector<RandomGenerators::VolumeElementSampler>().swap(m_VolumeElementSamplers);
+    m_VolumeElementSamplerIndex = vector<int>(Nspecies, -1);
+
+    // Representative species and its total weight for each of the samplers
+    vector<int> representatives;
+    vector<double> totals;
+    vector< vector<double> > repweights;
+    for (int ipart = 0; ipart < Nspecies; ++ipart) {
+      const ThermalParticle& part = TPS->Particle(ipart);
+      double total = 0.;
+      for (int ielem = 0; ielem < Nelem; ++ielem)
+        total += allweights[ipart][ielem];
+
+      // Look for a sampler with proportional weights
+      if (m_SamplerSharingTolerance >= 0. && total > 0.) {
+        for (size_t isam = 0; isam < representatives.size() && m_VolumeElementSamplerIndex[ipart] < 0; ++isam) {
+          const ThermalParticle& rep = TPS->Particle(representatives[isam]);
+          if (part.Statistics() != rep.Statistics()
+            || part.BaryonCharge() != rep.BaryonCharge()
+            || part.ElectricCharge() != rep.ElectricCharge()
+            || part.Strangeness() != rep.Strangeness()
+            || part.Charm() != rep.Charm()
+            || abs(part.Mass() - rep.Mass()) > 1.e-3 * rep.Mass() + m_SamplerSharingTolerance)
+            continue;
+
+          const vector<double>& wrep = repweights[isam];
+          bool proportional = true;
+          for (int ielem = 0; ielem < Nelem && proportional; ++ielem) {
+            double w1 = allweights[ipart][ielem] / total;
+            double w2 = wrep[ielem] / totals[isam];
+            if (abs(w1 - w2) > m_SamplerSharingTolerance * std::max(abs(w1), abs(w2)))
+              proportional = false;
+          }
+
+          if (proportional)
+            m_VolumeElementSamplerIndex[ipart] = isam;
+        }
+      }
+
+      if (m_VolumeElementSamplerIndex[ipart] < 0) {
+        m_VolumeElementSamplerIndex[ipart] = m_VolumeElementSamplers.size();
+        m_VolumeElementSamplers.push_back(RandomGenerators::VolumeElementSampler(allweights[ipart]));
+        representatives.push_back(ipart);
+        totals.push_back(total);
+        repweights.push_back(vector<double>());
+        repweights.back().swap(allweights[ipart]);
+      }
+      else {
+        // Free memory
+        vector<double>().swap(allweights[ipart]);
+      }
+    }
+
+    cout << "Using " << m_VolumeElementSamplers.size() << " volume element samplers for " << Nspecies << " species" << endl;
+  }
+
   std::vector<std::vector<double>> HypersurfaceEventGenerator::CalculateTMuMap(ThermalModelBase* model, double edens, double rhomin, double rhomax, double drho)
   {
     cout << "Remapping T and mu along e = " << edens << " surface..." << endl;
@@ -341,8 +477,9 @@ namespace thermalfist {
         m_MomentumGens.push_back(new RandomGenerators::HypersurfaceMomentumGenerator(
           m_ParticlizationHypersurface,
           &m_THM->TPS()->Particle(i),
-          &m_VolumeElementSamplers[i],
-          GetEtaSmear()
+          &m_VolumeElementSamplers[m_VolumeElementSamplerIndex[i]],
+          GetEtaSmear(),
+          GetMomentumBatchSize()
         ));
 
         // Should not be used
@@ -570,6 +707,157 @@ namespace thermalfist {
     return { part.px, part.py, part.pz, r0, rx, ry, rz };
   }
 
+  void RandomGenerators::HypersurfaceMomentumGenerator::SamplePhaseSpaceCoordinatesFromElements(
+    const ParticlizationHypersurface* hypersurface,
+    const std::vector<int>& elements,
+    const ThermalParticle* particle,
+    PhaseSpaceCoordinatesBatch& batch,
+    double mass,
+    double etasmear)
+  {
+    int N = elements.size();
+    batch.resize(N);
+
+    if (particle == NULL || hypersurface == NULL) {
+      printf("**ERROR** in HypersurfaceMomentumGenerator::SamplePhaseSpaceCoordinatesFromElements(): Unknown particle species or hypersurface!\n");
+      for (int i = 0; i < N; ++i)
+        batch.px[i] = batch.py[i] = batch.pz[i] = batch.r0[i] = batch.rx[i] = batch.ry[i] = batch.rz[i] = 0.;
+      return;
+    }
+
+    if (mass < 0.)
+      mass = particle->Mass();
+
+    // Flow velocities and dsigma^\mu in the local rest frame, one per particle
+    std::vector<double> vx(N), vy(N), vz(N);
+    std::vector<double> ds0(N), ds1(N), ds2(N), ds3(N);
+    std::vector<double> T(N), mu(N);
+    for (int i = 0; i < N; ++i) {
+      const ParticlizationHypersurfaceElement& elem = (*hypersurface)[elements[i]];
+      vx[i] = elem.u[1] / elem.u[0];
+      vy[i] = elem.u[2] / elem.u[0];
+      vz[i] = elem.u[3] / elem.u[0];
+      ds0[i] = elem.dsigma[0];
+      ds1[i] = -elem.dsigma[1];
+      ds2[i] = -elem.dsigma[2];
+      ds3[i] = -elem.dsigma[3];
+      T[i] = elem.T;
+      mu[i] = particle->BaryonCharge() * elem.muB + particle->ElectricCharge() * elem.muQ + particle->Strangeness() * elem.muS;
+    }
+
+    // Boost dsigma^\mu to the local rest frame
+    std::vector<double> gamma(N), gm1v2(N);
+    for (int i = 0; i < N; ++i) {
+      double v2 = vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i];
+      gamma[i] = 1. / sqrt(1. - v2);
+      gm1v2[i] = (v2 > 0.) ? (gamma[i] - 1.) / v2 : 0.;
+      double vr = vx[i] * ds1[i] + vy[i] * ds2[i] + vz[i] * ds3[i];
+      double t0 = gamma[i] * (ds0[i] - vr);
+      double coef = -gamma[i] * ds0[i] + gm1v2[i] * vr;
+      ds1[i] += coef * vx[i];
+      ds2[i] += coef * vy[i];
+      ds3[i] += coef * vz[i];
+      ds0[i] = t0;
+    }
+
+    // Maximum weight for the rejection sampling of the momentum
+    std::vector<double> invMaxWeight(N);
+    for (int i = 0; i < N; ++i)
+      invMaxWeight[i] = 1. / (1. + std::abs(ds1[i] / ds0[i]) + std::abs(ds2[i] / ds0[i]) + std::abs(ds3[i] / ds0[i]));
+
+    // One thermal momentum generator per distinct (T,mu) pair
+    std::vector<int> order(N);
+    for (int i = 0; i < N; ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), [&T, &mu](int a, int b) {
+      return T[a] < T[b] || (T[a] == T[b] && mu[a] < mu[b]);
+    });
+    std::vector<ThermalMomentumGenerator> generators;
+    std::vector<int> generatorIndex(N);
+    for (int k = 0; k < N; ++k) {
+      int i = order[k];
+      if (k == 0 || T[i] != T[order[k - 1]] || mu[i] != mu[order[k - 1]])
+        generators.push_back(ThermalMomentumGenerator(mass, particle->Statistics(), T[i], mu[i]));
+      generatorIndex[i] = generators.size() - 1;
+    }
+
+    // Rejection sampling over all the particles not yet accepted
+    std::vector<int> pending(order);
+    std::vector<double> tpx(N), tpy(N), tpz(N), tp0(N), weight(N);
+    std::vector<double>& px = batch.px;
+    std::vector<double>& py = batch.py;
+    std::vector<double>& pz = batch.pz;
+    std::vector<double> p0(N);
+    while (!pending.empty()) {
+      int Np = pending.size();
+
+      for (int k = 0; k < Np; ++k) {
+        double tp = generators[generatorIndex[pending[k]]].GetP(mass);
+        double tphi = 2. * xMath::Pi() * RandomGenerators::randgenMT.rand();
+        double cthe = 2. * RandomGenerators::randgenMT.rand() - 1.;
+        double sthe = sqrt(1. - cthe * cthe);
+        tpx[k] = tp * cos(tphi) * sthe;
+        tpy[k] = tp * sin(tphi) * sthe;
+        tpz[k] = tp * cthe;
+        tp0[k] = sqrt(mass * mass + tp * tp);
+      }
+
+      for (int k = 0; k < Np; ++k) {
+        int i = pending[k];
+        double dsigmamu_pmu_loc = ds0[i] * tp0[k] - ds1[i] * tpx[k] - ds2[i] * tpy[k] - ds3[i] * tpz[k];
+        weight[k] = dsigmamu_pmu_loc / ds0[i] / tp0[k] * invMaxWeight[i];
+      }
+
+      int Nleft = 0;
+      for (int k = 0; k < Np; ++k) {
+        int i = pending[k];
+        if (weight[k] > 1.) {
+          printf("**WARNING** HypersurfaceMomentumGenerator::SamplePhaseSpaceCoordinatesFromElements: Weight exceeds unity by %E\n",
+            weight[k] - 1.);
+        }
+        if (RandomGenerators::randgenMT.rand() < weight[k]) {
+          px[i] = tpx[k];
+          py[i] = tpy[k];
+          pz[i] = tpz[k];
+          p0[i] = tp0[k];
+        }
+        else {
+          pending[Nleft++] = i;
+        }
+      }
+      pending.resize(Nleft);
+    }
+
+    // Boost from the local rest frame of the fluid
+    for (int i = 0; i < N; ++i) {
+      double vp = vx[i] * px[i] + vy[i] * py[i] + vz[i] * pz[i];
+      double coef = gamma[i] * p0[i] + gm1v2[i] * vp;
+      p0[i] = gamma[i] * (p0[i] + vp);
+      px[i] += coef * vx[i];
+      py[i] += coef * vy[i];
+      pz[i] += coef * vz[i];
+    }
+
+    // Space-time coordinates, with smearing in eta
+    for (int i = 0; i < N; ++i) {
+      const ParticlizationHypersurfaceElement& elem = (*hypersurface)[elements[i]];
+      double eta = elem.eta;
+
+      if (etasmear > 0.0) {
+        double deta = -0.5 * etasmear + 1. * etasmear * RandomGenerators::randgenMT.rand();
+        double mt = sqrt(mass * mass + px[i] * px[i] + py[i] * py[i]);
+        double y = 0.5 * log((p0[i] + pz[i]) / (p0[i] - pz[i]));
+        pz[i] = mt * std::sinh(y + deta);
+        eta += deta;
+      }
+
+      batch.r0[i] = elem.tau * cosh(eta);
+      batch.rz[i] = elem.tau * sinh(eta);
+      batch.rx[i] = elem.x;
+      batch.ry[i] = elem.y;
+    }
+  }
+
   BoostInvariantHypersurfaceEventGenerator::BoostInvariantHypersurfaceEventGenerator(ThermalParticleSystem* TPS, const EventGeneratorConfiguration& config, double etamax, const ParticlizationHypersurface* hypersurface)
     : m_VolumeElementSampler(NULL)
   {
@@ -646,9 +934,10 @@ namespace thermalfist {
     SimpleEvent ret = SampleParticles(yields);
 
     if (DoDecays)
-      return PerformDecays(ret, m_THM->TPS());
-    else
-      return ret;
+      return PerformDecays(ret, m_THM->TPS(), AcceptanceFilter());
+
+    ApplyAcceptanceFilter(ret);
+    return ret;
   }
 
   double HypersurfaceEventGeneratorEVHRG::EVHRGWeight(int sampledN, double meanN, double V, double b)
@@ -0,0 +1,87 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include "HRGEventGenerator/MultiplicityClassEventGenerator.h"
+
+#include <algorithm>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+#include "HRGEventGenerator/RandomGenerators.h"
+
+namespace thermalfist {
+
+  MultiplicityClassEventGenerator::MultiplicityClassEventGenerator(ThermalParticleSystem* TPS, const EventGeneratorConfiguration& config, const std::vector<MultiplicityClass>& classes) :
+    m_Classes(classes),
+    m_NumberOfThreads(0),
+    m_Seed(0)
+  {
+    m_Generators.resize(m_Classes.size());
+    m_ExpectedCosts.resize(m_Classes.size());
+    for (size_t iclass = 0; iclass < m_Classes.size(); ++iclass) {
+      const MultiplicityClass& cl = m_Classes[iclass];
+
+      EventGeneratorConfiguration classConfig = config;
+      classConfig.CFOParameters.T = cl.T;
+      classConfig.CFOParameters.gammaS = cl.gammaS;
+      classConfig.CFOParameters.V = cl.V;
+      classConfig.CFOParameters.SVc = (cl.Vc > 0.) ? cl.Vc : cl.V;
+
+      double betas = (2. + cl.n) / 2. * cl.betaT;
+      m_Generators[iclass] = new CylindricalBlastWaveEventGenerator(TPS, classConfig, cl.Tkin, betas, cl.etamax, cl.n);
+
+      // Set up the momentum generators now rather than at the first event
+      m_Generators[iclass]->CheckSetParameters();
+
+      const ThermalModelBase* model = m_Generators[iclass]->ThermalModel();
+      double multiplicity = 0.;
+      for (size_t i = 0; i < model->Densities().size(); ++i)
+        multiplicity += model->Densities()[i];
+      multiplicity *= model->Volume();
+      m_ExpectedCosts[iclass] = cl.nevents * std::max(1., multiplicity);
+    }
+  }
+
+  MultiplicityClassEventGenerator::~MultiplicityClassEventGenerator()
+  {
+    for (size_t iclass = 0; iclass < m_Generators.size(); ++iclass)
+      delete m_Generators[iclass];
+  }
+
+  void MultiplicityClassEventGenerator::Run(EventHandler* handler, bool performDecays)
+  {
+    int nclasses = m_Classes.size();
+
+    // The most expensive classes first
+    std::vector< std::pair<double, int> > order(nclasses);
+    for (int iclass = 0; iclass < nclasses; ++iclass)
+      order[iclass] = std::make_pair(-m_ExpectedCosts[iclass], iclass);
+    std::sort(order.begin(), order.end());
+
+    unsigned int seed = m_Seed;
+    if (seed == 0)
+      seed = RandomGenerators::randgenMT.randInt();
+
+#ifdef USE_OPENMP
+    int nthreads = (m_NumberOfThreads > 0) ? m_NumberOfThreads : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+#endif
+    for (int ind = 0; ind < nclasses; ++ind) {
+      int iclass = order[ind].second;
+      RandomGenerators::SetSeed(seed + iclass);
+      CylindricalBlastWaveEventGenerator* generator = m_Generators[iclass];
+      for (long long iev = 0; iev < m_Classes[iclass].nevents; ++iev) {
+        SimpleEvent ev = generator->GetEvent(performDecays);
+        if (handler != NULL)
+          handler->ProcessEvent(iclass, iev, ev);
+      }
+    }
+  }
+
+} // namespace thermalfist
@@ -0,0 +1,207 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include "HRGEventGenerator/PairCorrelations.h"
+
+#include <cstdio>
+#include <cmath>
+
+#include "HRGBase/xMath.h"
+
+namespace thermalfist {
+
+  PairCorrelationAccumulator::PairCorrelationAccumulator(const std::vector<long long>& speciesA, const std::vector<long long>& speciesB,
+    int nbinsDy, double dymax, int nbinsDphi, int mixingDepth) :
+    m_NbinsDy(nbinsDy),
+    m_DyMax(dymax),
+    m_NbinsDphi(nbinsDphi),
+    m_MixingDepth(mixingDepth)
+  {
+    if (m_NbinsDy < 1 || m_NbinsDphi < 1 || m_DyMax <= 0.) {
+      printf("**WARNING** PairCorrelationAccumulator: Invalid binning, using the default one\n");
+      m_NbinsDy = 40;
+      m_DyMax = 2.;
+      m_NbinsDphi = 36;
+    }
+    if (m_MixingDepth < 0)
+      m_MixingDepth = 0;
+
+    m_BinWidthDy = 2. * m_DyMax / m_NbinsDy;
+    m_BinWidthDphi = 2. * xMath::Pi() / m_NbinsDphi;
+
+    // Bits 0-3 correspond to the sets A, anti-A, B, anti-B
+    for (size_t i = 0; i < speciesA.size(); ++i) {
+      m_SpeciesMask[speciesA[i]] |= 1;
+      m_SpeciesMask[-speciesA[i]] |= 2;
+    }
+    for (size_t i = 0; i < speciesB.size(); ++i) {
+      m_SpeciesMask[speciesB[i]] |= 4;
+      m_SpeciesMask[-speciesB[i]] |= 8;
+    }
+
+    Clear();
+  }
+
+  void PairCorrelationAccumulator::Clear()
+  {
+    m_NumberOfEvents = 0;
+    m_SumOfWeights = 0.;
+    for (int i = 0; i < 2; ++i) {
+      m_TriggerCounts[i] = 0.;
+      m_MixedTriggerCounts[i] = 0.;
+    }
+    for (int i = 0; i < 4; ++i) {
+      m_Same[i].assign(m_NbinsDy * m_NbinsDphi, 0.);
+      m_Mixed[i].assign(m_NbinsDy * m_NbinsDphi, 0.);
+    }
+    m_PoolB.clear();
+    m_PoolBbar.clear();
+  }
+
+  double PairCorrelationAccumulator::DphiBinCenter(int iphi) const
+  {
+    return -0.5 * xMath::Pi() + (iphi + 0.5) * m_BinWidthDphi;
+  }
+
+  void PairCorrelationAccumulator::FillPairs(const std::vector<Track>& tracksA, const std::vector<Track>& tracksB, bool sameEvent, double weight, std::vector<double>& hist) const
+  {
+    const double twopi = 2. * xMath::Pi();
+    for (size_t i = 0; i < tracksA.size(); ++i) {
+      const Track& ta = tracksA[i];
+      for (size_t j = 0; j < tracksB.size(); ++j) {
+        const Track& tb = tracksB[j];
+        if (sameEvent && ta.index == tb.index)
+          continue;
+
+        double dy = tb.y - ta.y;
+        if (dy <= -m_DyMax || dy >= m_DyMax)
+          continue;
+        int iy = static_cast<int>((dy + m_DyMax) / m_BinWidthDy);
+        if (iy >= m_NbinsDy)
+          iy = m_NbinsDy - 1;
+
+        // Delta phi in [-pi/2, 3pi/2)
+        double dphi = tb.phi - ta.phi + 0.5 * xMath::Pi();
+        dphi -= twopi * floor(dphi / twopi);
+        int iphi = static_cast<int>(dphi / m_BinWidthDphi);
+        if (iphi >= m_NbinsDphi)
+          iphi = m_NbinsDphi - 1;
+
+        hist[iy * m_NbinsDphi + iphi] += weight;
+      }
+    }
+  }
+
+  void PairCorrelationAccumulator::AddEvent(const SimpleEvent& ev)
+  {
+    for (int i = 0; i < 4; ++i)
+      m_Tracks[i].clear();
+
+    for (size_t ipart = 0; ipart < ev.Particles.size(); ++ipart) {
+      const SimpleParticle& part = ev.Particles[ipart];
+      std::map<long long, int>::const_iterator it = m_SpeciesMask.find(part.PDGID);
+      if (it == m_SpeciesMask.end())
+        continue;
+      Track track;
+      track.y = part.GetY();
+      track.phi = atan2(part.py, part.px);
+      track.index = ipart;
+      for (int i = 0; i < 4; ++i)
+        if (it->second & (1 << i))
+          m_Tracks[i].push_back(track);
+    }
+
+    const std::vector<Track>& tracksA = m_Tracks[0];
+    const std::vector<Track>& tracksAbar = m_Tracks[1];
+    const std::vector<Track>& tracksB = m_Tracks[2];
+    const std::vector<Track>& tracksBbar = m_Tracks[3];
+
+    double weight = ev.weight;
+    m_NumberOfEvents++;
+    m_SumOfWeights += weight;
+    m_TriggerCounts[0] += weight * tracksA.size();
+    m_TriggerCounts[1] += weight * tracksAbar.size();
+
+    FillPairs(tracksA, tracksB, true, weight, m_Same[AB]);
+    FillPairs(tracksA, tracksBbar, true, weight, m_Same[ABbar]);
+    FillPairs(tracksAbar, tracksB, true, weight, m_Same[AbarB]);
+    FillPairs(tracksAbar, tracksBbar, true, weight, m_Same[AbarBbar]);
+
+    // Mixed events
+    for (size_t iev = 0; iev < m_PoolB.size(); ++iev) {
+      m_MixedTriggerCounts[0] += weight * tracksA.size();
+      m_MixedTriggerCounts[1] += weight * tracksAbar.size();
+      FillPairs(tracksA, m_PoolB[iev], false, weight, m_Mixed[AB]);
+      FillPairs(tracksA, m_PoolBbar[iev], false, weight, m_Mixed[ABbar]);
+      FillPairs(tracksAbar, m_PoolB[iev], false, weight, m_Mixed[AbarB]);
+      FillPairs(tracksAbar, m_PoolBbar[iev], false, weight, m_Mixed[AbarBbar]);
+    }
+
+    if (m_MixingDepth > 0) {
+      if (static_cast<int>(m_PoolB.size()) == m_MixingDepth) {
+        m_PoolB.pop_front();
+        m_PoolBbar.pop_front();
+      }
+      m_PoolB.push_back(tracksB);
+      m_PoolBbar.push_back(tracksBbar);
+    }
+  }
+
+  void PairCorrelationAccumulator::Merge(const PairCorrelationAccumulator& other)
+  {
+    if (other.m_NbinsDy != m_NbinsDy || other.m_NbinsDphi != m_NbinsDphi
+      || other.m_DyMax != m_DyMax || other.m_SpeciesMask != m_SpeciesMask) {
+      printf("**WARNING** PairCorrelationAccumulator::Merge: Incompatible accumulators, skipping\n");
+      return;
+    }
+
+    m_NumberOfEvents += other.m_NumberOfEvents;
+    m_SumOfWeights += other.m_SumOfWeights;
+    for (int i = 0; i < 2; ++i) {
+      m_TriggerCounts[i] += other.m_TriggerCounts[i];
+      m_MixedTriggerCounts[i] += other.m_MixedTriggerCounts[i];
+    }
+    for (int i = 0; i < 4; ++i) {
+      for (size_t j = 0; j < m_Same[i].size(); ++j) {
+        m_Same[i][j] += other.m_Same[i][j];
+        m_Mixed[i][j] += other.m_Mixed[i][j];
+      }
+    }
+  }
+
+  double PairCorrelationAccumulator::Correlation(PairType type, int iy, int iphi) const
+  {
+    bool anti = (type == AbarB || type == AbarBbar);
+    double mixed = MixedEventPairs(type, iy, iphi);
+    if (mixed == 0. || TriggerCount(anti) == 0.)
+      return 0.;
+    return (SameEventPairs(type, iy, iphi) / TriggerCount(anti)) / (mixed / MixedTriggerCount(anti));
+  }
+
+  double PairCorrelationAccumulator::PairDensity(const std::vector<double>& hist, double triggers, int iy) const
+  {
+    if (triggers == 0.)
+      return 0.;
+    double ret = 0.;
+    for (int iphi = 0; iphi < m_NbinsDphi; ++iphi)
+      ret += hist[iy * m_NbinsDphi + iphi];
+    return ret / triggers / m_BinWidthDy;
+  }
+
+  double PairCorrelationAccumulator::BalanceFunction(int iy, bool mixedSubtracted) const
+  {
+    double ret = 0.;
+    ret += PairDensity(m_Same[ABbar], m_TriggerCounts[0], iy) - PairDensity(m_Same[AB], m_TriggerCounts[0], iy);
+    ret += PairDensity(m_Same[AbarB], m_TriggerCounts[1], iy) - PairDensity(m_Same[AbarBbar], m_TriggerCounts[1], iy);
+    if (mixedSubtracted) {
+      ret -= PairDensity(m_Mixed[ABbar], m_MixedTriggerCounts[0], iy) - PairDensity(m_Mixed[AB], m_MixedTriggerCounts[0], iy);
+      ret -= PairDensity(m_Mixed[AbarB], m_MixedTriggerCounts[1], iy) - PairDensity(m_Mixed[AbarBbar], m_MixedTriggerCounts[1], iy);
+    }
+    return 0.5 * ret;
+  }
+
+} // namespace thermalfist
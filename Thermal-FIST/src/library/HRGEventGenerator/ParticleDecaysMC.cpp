@@ -7,6 +7,9 @@
  */
 #include "HRGEventGenerator/ParticleDecaysMC.h"
 
+#include <map>
+#include <iostream>
+
 #include "HRGBase/xMath.h"
 #include "HRGEventGenerator/RandomGenerators.h"
 
@@ -41,7 +44,50 @@ namespace thermalfist {
       return sqrt(ThreeBodym12F2((m1 + m2) / 2., M, m1_, m2_, m3_));
     }
 
-    int threebodysucc = 0, threebodytot = 0;
+    namespace {
+      // Maxima of the m12 density for a given set of daughter masses,
+      // tabulated at the kinetic energy release values Q_k = QMin * QRatio^k
+      struct ThreeBodym12MaximumTable {
+        std::vector<double> Maxima;
+      };
+
+      const double QMin = 1.e-4;
+      const double QRatio = 1.005;
+      const double LogQRatio = log(QRatio);
+
+      typedef std::pair< std::pair<double, double>, double > ThreeBodyMasses;
+#ifdef USE_OPENMP
+      thread_local std::map<ThreeBodyMasses, ThreeBodym12MaximumTable> ThreeBodym12MaximumTables;
+#else
+      std::map<ThreeBodyMasses, ThreeBodym12MaximumTable> ThreeBodym12MaximumTables;
+#endif
+    }
+
+    double ThreeBodym12MaximumCached(double M, double m1, double m2, double m3)
+    {
+      ThreeBodym12MaximumTable& table = ThreeBodym12MaximumTables[std::make_pair(std::make_pair(m1, m2), m3)];
+
+      double Q = M - m1 - m2 - m3;
+      int k = 0;
+      if (Q > QMin)
+        k = static_cast<int>(ceil(log(Q / QMin) / LogQRatio));
+      // Round-off safety
+      double Qk = QMin * pow(QRatio, k);
+      if (Qk < Q) {
+        k++;
+        Qk *= QRatio;
+      }
+
+      if (k >= static_cast<int>(table.Maxima.size()))
+        table.Maxima.resize(k + 1, -1.);
+
+      if (table.Maxima[k] < 0.)
+        table.Maxima[k] = TernaryThreeBodym12Maximum(m1 + m2 + m3 + Qk, m1, m2, m3);
+
+      return table.Maxima[k];
+    }
+
+    thread_local int threebodysucc = 0, threebodytot = 0;
 
     // Random sample for m12 in a 3-body decay
     double GetRandomThreeBodym12(double M, double m1_, double m2_, double m3_, double fm12max) {
@@ -165,25 +211,168 @@ namespace thermalfist {
       return ret;
     }
 
-    std::vector<SimpleParticle> ManyBodyDecay(const SimpleParticle & Mother, std::vector<double> masses, std::vector<long long> pdgs) {
-      std::vector<SimpleParticle> ret(0);
-      if (masses.size() < 1) return ret;
+    namespace {
+      // Momentum of the decay products in a two-body decay a -> b + c
+      inline double TwoBodyMomentum(double a, double b, double c) {
+        double x = (a - b - c) * (a + b + c) * (a - b + c) * (a + b - c);
+        if (x <= 0.)
+          return 0.;
+        return sqrt(x) / (2. * a);
+      }
+
+      // Random isotropic direction
+      inline void RandomDirection(double& nx, double& ny, double& nz) {
+        double tphi = 2. * xMath::Pi() * RandomGenerators::randgenMT.rand();
+        double cthe = 2. * RandomGenerators::randgenMT.rand() - 1.;
+        double sthe = sqrt(1. - cthe * cthe);
+        nx = cos(tphi) * sthe;
+        ny = sin(tphi) * sthe;
+        nz = cthe;
+      }
+
+      // Lorentz boost of a four-momentum (p0, px, py, pz) by velocity (vx, vy, vz)
+      inline void BoostFourMomentum(double* p, double vx, double vy, double vz) {
+        double v2 = vx * vx + vy * vy + vz * vz;
+        if (v2 == 0.0)
+          return;
+        double gamma = 1. / sqrt(1. - v2);
+        double vp = vx * p[1] + vy * p[2] + vz * p[3];
+        double coef = (gamma - 1.) * vp / v2 + gamma * p[0];
+        p[0] = gamma * (p[0] + vp);
+        p[1] += coef * vx;
+        p[2] += coef * vy;
+        p[3] += coef * vz;
+      }
+
+      void NBodyPhaseSpaceImpl(double M, int n, const double* masses, double* momenta,
+        double* rno, double* invMas, double* pd) {
+        double TeCM = M;
+        for (int i = 0; i < n; ++i)
+          TeCM -= masses[i];
+
+        // Maximum weight
+        double emmax = TeCM + masses[0];
+        double emmin = 0.;
+        double wtmax = 1.;
+        for (int i = 1; i < n; ++i) {
+          emmin += masses[i - 1];
+          emmax += masses[i];
+          wtmax *= TwoBodyMomentum(emmax, emmin, masses[i]);
+        }
+
+        // Invariant masses of the subsystems of the first i + 1 particles
+        while (true) {
+          rno[0] = 0.;
+          rno[n - 1] = 1.;
+          for (int i = 1; i < n - 1; ++i) {
+            double r = RandomGenerators::randgenMT.rand();
+            int j = i;
+            for (; j > 1 && rno[j - 1] > r; --j)
+              rno[j] = rno[j - 1];
+            rno[j] = r;
+          }
+
+          double wt = 1., sum = 0.;
+          for (int i = 0; i < n; ++i) {
+            sum += masses[i];
+            invMas[i] = rno[i] * TeCM + sum;
+          }
+          for (int i = 0; i < n - 1; ++i) {
+            pd[i] = TwoBodyMomentum(invMas[i + 1], invMas[i], masses[i + 1]);
+            wt *= pd[i];
+          }
+
+          if (wt >= wtmax * RandomGenerators::randgenMT.rand())
+            break;
+        }
+
+        // Build the momenta successively in the rest frames of the subsystems
+        momenta[0] = sqrt(pd[0] * pd[0] + masses[0] * masses[0]);
+        momenta[1] = 0.;
+        momenta[2] = pd[0];
+        momenta[3] = 0.;
+        momenta[4] = sqrt(pd[0] * pd[0] + masses[1] * masses[1]);
+        momenta[5] = 0.;
+        momenta[6] = -pd[0];
+        momenta[7] = 0.;
+        int i = 1;
+        while (true) {
+          // Random rotation of the subsystem
+          double cZ = 2. * RandomGenerators::randgenMT.rand() - 1.;
+          double sZ = sqrt(1. - cZ * cZ);
+          double angY = 2. * xMath::Pi() * RandomGenerators::randgenMT.rand();
+          double cY = cos(angY);
+          double sY = sin(angY);
+          for (int j = 0; j <= i; ++j) {
+            double* p = momenta + 4 * j;
+            double x = p[1], y = p[2];
+            p[1] = cZ * x - sZ * y;
+            p[2] = sZ * x + cZ * y;
+            x = p[1];
+            double z = p[3];
+            p[1] = cY * x - sY * z;
+            p[3] = sY * x + cY * z;
+          }
+
+          if (i == n - 1)
+            break;
+
+          // Boost the subsystem opposite to the next particle
+          double beta = pd[i] / sqrt(pd[i] * pd[i] + invMas[i] * invMas[i]);
+          for (int j = 0; j <= i; ++j)
+            BoostFourMomentum(momenta + 4 * j, 0., beta, 0.);
+
+          i++;
+          double* p = momenta + 4 * i;
+          p[0] = sqrt(pd[i - 1] * pd[i - 1] + masses[i] * masses[i]);
+          p[1] = 0.;
+          p[2] = -pd[i - 1];
+          p[3] = 0.;
+        }
+      }
+    }
+
+    void NBodyPhaseSpace(double M, int n, const double* masses, double* momenta)
+    {
+      if (n < 2)
+        return;
+      if (n <= MaxNBodyStackSize) {
+        double rno[MaxNBodyStackSize], invMas[MaxNBodyStackSize], pd[MaxNBodyStackSize];
+        NBodyPhaseSpaceImpl(M, n, masses, momenta, rno, invMas, pd);
+      }
+      else {
+        std::vector<double> rno(n), invMas(n), pd(n);
+        NBodyPhaseSpaceImpl(M, n, masses, momenta, &rno[0], &invMas[0], &pd[0]);
+      }
+    }
+
+    std::vector<SimpleParticle> ManyBodyDecay(const SimpleParticle & Mother, const std::vector<double>& masses, const std::vector<long long>& pdgs) {
+      std::vector<SimpleParticle> ret;
+      ManyBodyDecay(Mother, masses, pdgs, ret);
+      return ret;
+    }
+
+    void ManyBodyDecay(const SimpleParticle & Mother, const std::vector<double>& masses, const std::vector<long long>& pdgs, std::vector<SimpleParticle>& decayProducts) {
+      decayProducts.clear();
+      if (masses.size() < 1) return;
 
       // If only one daughter listed, assume a radiative decay A -> B + gamma
       if (masses.size() == 1)
       {
-        masses.push_back(0.);
-        pdgs.push_back(22);
+        std::vector<double> masses2(1, masses[0]);
+        std::vector<long long> pdgs2(1, pdgs[0]);
+        masses2.push_back(0.);
+        pdgs2.push_back(22);
+        ManyBodyDecay(Mother, masses2, pdgs2, decayProducts);
+        return;
       }
 
-      if (masses.size() > 3) {
-        ShuffleDecayProducts(masses, pdgs);
-      }
+      int n = masses.size();
 
       SimpleParticle Mother2 = Mother;
       // Mass validation
       double tmasssum = 0.;
-      for (size_t i = 0; i < masses.size(); ++i)
+      for (int i = 0; i < n; ++i)
         tmasssum += masses[i];
 
       // If sum of decay product masses larger than the mother particle mass (happens with zero-width resonances),
@@ -193,37 +382,81 @@ namespace thermalfist {
         Mother2.p0 = sqrt(Mother2.px * Mother2.px + Mother2.py * Mother2.py + Mother2.pz * Mother2.pz + Mother2.m * Mother2.m);
       }
 
-      if (masses.size() == 2) return TwoBodyDecay(Mother2, masses[0], pdgs[0], masses[1], pdgs[1]);
-      double tmin = 0.;
-      for (size_t i = 0; i < masses.size() - 1; ++i) tmin += masses[i];
-      double tmax = Mother2.m - masses[masses.size() - 1];
-      double mijk = 0.;
-      if (masses.size() == 3) {
-        mijk = GetRandomThreeBodym12(Mother2.m, masses[0], masses[1], masses[2], 1.01*TernaryThreeBodym12Maximum(Mother2.m, masses[0], masses[1], masses[2]));
+      if (n == 2) {
+        decayProducts = TwoBodyDecay(Mother2, masses[0], pdgs[0], masses[1], pdgs[1]);
+        return;
       }
-      else // More than 3 body decay kinematics are only approximate!
-      {
-        mijk = tmin + (tmax - tmin) * RandomGenerators::randgenMT.rand();
+
+      // Four-momenta in the rest frame of the mother particle
+      double momentaStack[4 * MaxNBodyStackSize];
+      std::vector<double> momentaHeap;
+      double* momenta = momentaStack;
+      if (n > MaxNBodyStackSize) {
+        momentaHeap.resize(4 * n);
+        momenta = &momentaHeap[0];
       }
-      std::vector<SimpleParticle> ret1 = TwoBodyDecay(Mother2, mijk, 11111, masses[masses.size() - 1], pdgs[pdgs.size() - 1]);
-      ret.push_back(ret1[1]);
-      masses.resize(masses.size() - 1);
-      pdgs.resize(pdgs.size() - 1);
-      ret1 = ManyBodyDecay(ret1[0], masses, pdgs);
-      for (size_t i = 0; i < ret1.size(); ++i)
-        ret.push_back(ret1[i]);
-
-      for (size_t i = 0; i < ret.size(); ++i) {
-        ret[i].MotherPDGID = Mother.PDGID;
-        ret[i].epoch = Mother.epoch + 1;
+
+      // The decay products are ordered as (3, 1, 2) for three-body decays
+      int order[3] = { 2, 0, 1 };
+      if (n == 3) {
+        double M = Mother2.m;
+        double m12 = GetRandomThreeBodym12(M, masses[0], masses[1], masses[2], 1.01 * ThreeBodym12MaximumCached(M, masses[0], masses[1], masses[2]));
+
+        // Particle 3 recoils against the (12) pair
+        double p3 = TwoBodyMomentum(M, m12, masses[2]);
+        double nx, ny, nz;
+        RandomDirection(nx, ny, nz);
+        double* p = momenta + 4 * 2;
+        p[0] = sqrt(p3 * p3 + masses[2] * masses[2]);
+        p[1] = p3 * nx;
+        p[2] = p3 * ny;
+        p[3] = p3 * nz;
+        double E12 = sqrt(p3 * p3 + m12 * m12);
+        double v12x = -p3 * nx / E12, v12y = -p3 * ny / E12, v12z = -p3 * nz / E12;
+
+        // Particles 1 and 2 in the rest frame of the (12) pair
+        double p12 = TwoBodyMomentum(m12, masses[0], masses[1]);
+        RandomDirection(nx, ny, nz);
+        for (int i = 0; i < 2; ++i) {
+          double sgn = (i == 0) ? 1. : -1.;
+          p = momenta + 4 * i;
+          p[0] = sqrt(p12 * p12 + masses[i] * masses[i]);
+          p[1] = sgn * p12 * nx;
+          p[2] = sgn * p12 * ny;
+          p[3] = sgn * p12 * nz;
+          BoostFourMomentum(p, v12x, v12y, v12z);
+        }
+      }
+      else {
+        NBodyPhaseSpace(Mother2.m, n, &masses[0], momenta);
+      }
+
+      // Boost to the frame of the decaying particle
+      double vx = Mother2.px / Mother2.p0;
+      double vy = Mother2.py / Mother2.p0;
+      double vz = Mother2.pz / Mother2.p0;
+
+      decayProducts.resize(n, Mother2);
+      for (int i = 0; i < n; ++i) {
+        int id = (n == 3) ? order[i] : i;
+        double* p = momenta + 4 * id;
+        BoostFourMomentum(p, vx, vy, vz);
+        SimpleParticle& part = decayProducts[i];
+        part = Mother2;
+        part.m = masses[id];
+        part.PDGID = pdgs[id];
+        part.p0 = p[0];
+        part.px = p[1];
+        part.py = p[2];
+        part.pz = p[3];
+        part.MotherPDGID = Mother.PDGID;
+        part.epoch = Mother.epoch + 1;
       }
 
 #ifdef DEBUGDECAYS
-      for (int i = 0; i < ret.size(); ++i)
-        if (ret[i].px != ret[i].px) std::cout << "**WARNING** NaN in NBodyDecay procedure output!\n";
+      for (int i = 0; i < decayProducts.size(); ++i)
+        if (decayProducts[i].px != decayProducts[i].px) std::cout << "**WARNING** NaN in NBodyDecay procedure output!\n";
 #endif
-
-      return ret;
     }
 
     void ShuffleDecayProducts(std::vector<double>& masses, std::vector<long long>& pdgs)
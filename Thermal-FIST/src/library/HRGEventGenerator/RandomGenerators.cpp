@@ -7,6 +7,8 @@
  */
 #include "HRGEventGenerator/RandomGenerators.h"
 
+#include <algorithm>
+
 #include "HRGBase/xMath.h"
 #include "HRGEventGenerator/SimpleParticle.h"
 #include "HRGEventGenerator/ParticleDecaysMC.h"
@@ -16,7 +18,11 @@ namespace thermalfist {
 
   namespace RandomGenerators {
 
+#ifdef ThermalFIST_USE_OPENMP
+    thread_local MTRand randgenMT;
+#else
     MTRand randgenMT;
+#endif
 
     void SetSeed(const unsigned int seed) {
       randgenMT.seed(seed);
@@ -111,11 +117,133 @@ namespace thermalfist {
       //}
     }
 
+    int RandomBinomial(int n, double p) {
+      return RandomBinomial(n, p, randgenMT);
+    }
+
+    int RandomBinomial(int n, double p, MTRand &rangen) {
+      if (n <= 0 || p <= 0.) return 0;
+      if (p >= 1.) return n;
+      if (p > 0.5) return n - RandomBinomial(n, 1. - p, rangen);
+
+      double q = 1. - p;
+      double r = p / q;
+
+      // Small mean: sequential inversion from zero
+      if (n * p < 10.) {
+        double pk = pow(q, n);
+        double u = rangen.rand();
+        int k = 0;
+        while (u > pk && k < n) {
+          u -= pk;
+          pk *= r * (n - k) / (k + 1.);
+          k++;
+        }
+        return k;
+      }
+
+      // Inversion starting from the mode, alternating downward and upward steps
+      int mode = static_cast<int>((n + 1) * p);
+      if (mode > n) mode = n;
+      double pmode = exp(xMath::LogGamma(n + 1.) - xMath::LogGamma(mode + 1.) - xMath::LogGamma(n - mode + 1.)
+        + mode * log(p) + (n - mode) * log(q));
+
+      while (true) {
+        double u = rangen.rand();
+        u -= pmode;
+        if (u <= 0.) return mode;
+
+        int kdown = mode, kup = mode;
+        double pdown = pmode, pup = pmode;
+        while (kdown > 0 || kup < n) {
+          if (kdown > 0) {
+            pdown *= kdown / (r * (n - kdown + 1.));
+            kdown--;
+            u -= pdown;
+            if (u <= 0.) return kdown;
+          }
+          if (kup < n) {
+            pup *= r * (n - kup) / (kup + 1.);
+            kup++;
+            u -= pup;
+            if (u <= 0.) return kup;
+          }
+        }
+        // Round-off, repeat
+      }
+      return mode;
+    }
+
+    int RandomHypergeometric(int draws, int successes, int population) {
+      if (draws <= 0 || successes <= 0) return 0;
+      if (draws >= population) return successes;
+      if (successes >= population) return draws;
+
+      int failures = population - successes;
+      int kmin = std::max(0, draws - failures);
+      int kmax = std::min(draws, successes);
+
+      // Sequential inversion from the lowest possible value
+      double pk = exp(xMath::LogGamma(successes + 1.) - xMath::LogGamma(kmin + 1.) - xMath::LogGamma(successes - kmin + 1.)
+        + xMath::LogGamma(failures + 1.) - xMath::LogGamma(draws - kmin + 1.) - xMath::LogGamma(failures - draws + kmin + 1.)
+        - xMath::LogGamma(population + 1.) + xMath::LogGamma(draws + 1.) + xMath::LogGamma(population - draws + 1.));
+      double u = randgenMT.rand();
+      int k = kmin;
+      while (u > pk && k < kmax) {
+        u -= pk;
+        pk *= static_cast<double>(successes - k) * (draws - k) / ((k + 1.) * (failures - draws + k + 1.));
+        k++;
+      }
+      return k;
+    }
+
     double SkellamProbability(int k, double mu1, double mu2)
     {
       return exp(-(mu1 + mu2)) * pow(sqrt(mu1 / mu2), k) * xMath::BesselI(k, 2. * sqrt(mu1 * mu2));
     }
 
+    double SkellamLogProbability(int k, double mu1, double mu2)
+    {
+      const double logZero = -1.e100;
+
+      // Degenerate cases, Poisson distributions in k or -k
+      if (mu1 <= 0. || mu2 <= 0.) {
+        double mu = mu1;
+        if (mu2 > 0.) {
+          mu = mu2;
+          k = -k;
+        }
+        if (k < 0)
+          return logZero;
+        if (mu <= 0.)
+          return (k == 0) ? 0. : logZero;
+        return -mu + k * log(mu) - xMath::LogGamma(k + 1.);
+      }
+
+      double a = 2. * sqrt(mu1 * mu2);
+      double Iexp = xMath::BesselIexp(k, a);
+      if (!(Iexp > 0.))
+        return logZero;
+      return a - (mu1 + mu2) + 0.5 * k * log(mu1 / mu2) + log(Iexp);
+    }
+
+    int SkellamMode(double mu1, double mu2)
+    {
+      // The distribution is unimodal, climb from the mean
+      int k = static_cast<int>(floor(mu1 - mu2 + 0.5));
+      double logp = SkellamLogProbability(k, mu1, mu2);
+      for (int dir = -1; dir <= 1; dir += 2) {
+        while (true) {
+          double logpnext = SkellamLogProbability(k + dir, mu1, mu2);
+          if (!(logpnext > logp))
+            break;
+          k += dir;
+          logp = logpnext;
+        }
+      }
+      return k;
+    }
+
 
     double SiemensRasmussenMomentumGenerator::g(double x, double mass) const {
       if (mass < 0.)
@@ -279,20 +407,28 @@ namespace thermalfist {
 
 
     BoostInvariantMomentumGenerator::BoostInvariantMomentumGenerator(BoostInvariantFreezeoutParametrization* FreezeoutModel,
-      double Tkin, double etamax, double mass, int statistics, double mu) :
+      double Tkin, double etamax, double mass, int statistics, double mu, const BoostInvariantFreezeoutTable* FreezeoutTable) :
       m_FreezeoutModel(FreezeoutModel),
+      m_FreezeoutTable(FreezeoutTable),
+      m_OwnFreezeoutTable(false),
       m_Tkin(Tkin), m_EtaMax(etamax), m_Mass(mass),
       m_Generator(mass, statistics, Tkin, mu)
     {
       if (m_FreezeoutModel == NULL) {
         //m_FreezeoutModel = new BoostInvariantFreezeoutParametrization();
       }
+      if (m_FreezeoutTable == NULL && m_FreezeoutModel != NULL) {
+        m_FreezeoutTable = new BoostInvariantFreezeoutTable(*m_FreezeoutModel);
+        m_OwnFreezeoutTable = true;
+      }
     }
 
     BoostInvariantMomentumGenerator::~BoostInvariantMomentumGenerator()
     {
       if (m_FreezeoutModel != NULL)
         delete m_FreezeoutModel;
+      if (m_OwnFreezeoutTable)
+        delete m_FreezeoutTable;
     }
 
     std::vector<double> BoostInvariantMomentumGenerator::GetMomentum(double mass) const
@@ -305,7 +441,9 @@ namespace thermalfist {
       double eta = -EtaMax() + 2. * EtaMax() * RandomGenerators::randgenMT.rand();
       double ph = 2. * xMath::Pi() * RandomGenerators::randgenMT.rand();
 
-      double betar = m_FreezeoutModel->tanhetaperp(zetacand);
+      BoostInvariantFreezeoutTable::Point fo = m_FreezeoutTable->Interpolate(zetacand);
+
+      double betar = fo.tanhetaperp;
       double cosheta = cosh(eta);
       double sinheta = sinh(eta);
 
@@ -316,11 +454,8 @@ namespace thermalfist {
       double vy = betar * sinphi / cosheta;
       double vz = tanh(eta);
 
-      double dRdZeta = m_FreezeoutModel->dRdZeta(zetacand);
-      double dtaudZeta = m_FreezeoutModel->dtaudZeta(zetacand);
-
-      double coshetaperp = m_FreezeoutModel->coshetaperp(zetacand);
-      double sinhetaperp = m_FreezeoutModel->sinhetaperp(zetacand);
+      double dRdZeta = fo.dRdZeta;
+      double dtaudZeta = fo.dtaudZeta;
 
       std::vector<double> dsigma_lab;
       dsigma_lab.push_back(dRdZeta * cosheta);
@@ -380,11 +515,11 @@ namespace thermalfist {
       ret[2] = part.pz;
 
       // Space-time coordinates
-      double tau = m_FreezeoutModel->taufunc(zetacand);
+      double tau = fo.tau;
       double r0 = tau * cosheta;
       double rz = tau * sinheta;
 
-      double Rperp = m_FreezeoutModel->Rfunc(zetacand);
+      double Rperp = fo.R;
       double rx = Rperp * cosphi;
       double ry = Rperp * sinphi;
 
@@ -397,18 +532,10 @@ namespace thermalfist {
 
     double BoostInvariantMomentumGenerator::GetRandomZeta(MTRand& rangen) const
     {
-      if (m_FreezeoutModel->InverseZetaDistributionIsExplicit())
+      if (m_FreezeoutModel != NULL && m_FreezeoutModel->InverseZetaDistributionIsExplicit())
         return m_FreezeoutModel->InverseZetaDistribution(rangen.rand());
-      
-      while (1) {
-        double zetacand = rangen.rand();
-
-        double prob = m_FreezeoutModel->ZetaProbability(zetacand) / m_FreezeoutModel->ProbabilityMaximum();
 
-        if (rangen.rand() < prob)
-          return zetacand;
-      }
-      return 0.;
+      return m_FreezeoutTable->InverseZetaDistribution(rangen.rand());
     }
 
 
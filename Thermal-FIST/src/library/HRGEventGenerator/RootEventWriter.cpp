@@ -0,0 +1,182 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include "HRGEventGenerator/RootEventWriter.h"
+
+#include <cmath>
+#include <iostream>
+
+#ifdef USE_ROOT_TREE
+#include "TFile.h"
+#include "TTree.h"
+#endif
+
+namespace thermalfist {
+
+  RootEventWriter::RootEventWriter(const std::string& filename, const ThermalParticleSystem* TPS, const SimpleEvent::EventOutputConfig& config, int compression, int basketSize, const std::string& treeName) :
+    m_TPS(TPS), m_Config(config), m_Compression(compression), m_BasketSize(basketSize), m_TreeName(treeName),
+    m_File(NULL), m_Tree(NULL), m_Weight(1.), m_LogWeight(0.)
+  {
+    if (m_TPS == NULL)
+      std::cout << "**WARNING** RootEventWriter: No particle list provided, the charges of hadrons will be set to zero!" << std::endl;
+
+    if (!filename.empty())
+      OpenFile(filename);
+  }
+
+  RootEventWriter::~RootEventWriter()
+  {
+    CloseFile();
+  }
+
+  bool RootEventWriter::Available()
+  {
+#ifdef USE_ROOT_TREE
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  bool RootEventWriter::OpenFile(const std::string& filename)
+  {
+    CloseFile();
+
+#ifdef USE_ROOT_TREE
+    m_File = TFile::Open(filename.c_str(), "RECREATE", "", m_Compression);
+    if (m_File == NULL || m_File->IsZombie()) {
+      std::cout << "**WARNING** RootEventWriter: Cannot open file " << filename << std::endl;
+      delete m_File;
+      m_File = NULL;
+      return false;
+    }
+
+    m_EventNumber = 0;
+
+    m_Tree = new TTree(m_TreeName.c_str(), "Thermal-FIST events");
+    m_Tree->SetDirectory(m_File);
+
+    const int splitLevel = 99;
+    m_Tree->Branch("weight", &m_Weight, "weight/D");
+    m_Tree->Branch("logweight", &m_LogWeight, "logweight/D");
+    m_Tree->Branch("pdg", &m_PDG, m_BasketSize, splitLevel);
+    m_Tree->Branch("charge", &m_Charge, m_BasketSize, splitLevel);
+    m_Tree->Branch("pt", &m_Pt, m_BasketSize, splitLevel);
+    m_Tree->Branch("y", &m_Y, m_BasketSize, splitLevel);
+    m_Tree->Branch("eta", &m_Eta, m_BasketSize, splitLevel);
+    m_Tree->Branch("phi", &m_Phi, m_BasketSize, splitLevel);
+    m_Tree->Branch("m", &m_M, m_BasketSize, splitLevel);
+    if (m_Config.printCoordinates) {
+      m_Tree->Branch("r0", &m_R0, m_BasketSize, splitLevel);
+      m_Tree->Branch("rx", &m_Rx, m_BasketSize, splitLevel);
+      m_Tree->Branch("ry", &m_Ry, m_BasketSize, splitLevel);
+      m_Tree->Branch("rz", &m_Rz, m_BasketSize, splitLevel);
+    }
+    if (m_Config.printMotherPdg)
+      m_Tree->Branch("mother", &m_MotherPDG, m_BasketSize, splitLevel);
+    if (m_Config.printDecayEpoch)
+      m_Tree->Branch("epoch", &m_Epoch, m_BasketSize, splitLevel);
+
+    return true;
+#else
+    std::cout << "**WARNING** RootEventWriter: Thermal-FIST was compiled without the ROOT Tree library, cannot open " << filename << std::endl;
+    return false;
+#endif
+  }
+
+  void RootEventWriter::CloseFile()
+  {
+#ifdef USE_ROOT_TREE
+    if (m_File != NULL) {
+      m_File->cd();
+      m_Tree->Write();
+      m_File->Close();
+      // The tree is owned by the file and deleted on Close()
+      delete m_File;
+      m_File = NULL;
+      m_Tree = NULL;
+    }
+#endif
+  }
+
+  int RootEventWriter::Charge(long long pdgid) const
+  {
+    if (m_TPS != NULL) {
+      int id = m_TPS->PdgToId(pdgid);
+      if (id != -1)
+        return m_TPS->Particle(id).ElectricCharge();
+    }
+
+    // Charged leptons
+    long long abspdg = (pdgid > 0) ? pdgid : -pdgid;
+    if (abspdg == 11 || abspdg == 13 || abspdg == 15)
+      return (pdgid > 0) ? -1 : 1;
+
+    return 0;
+  }
+
+  void RootEventWriter::AddParticle(const SimpleParticle& part)
+  {
+    m_PDG.push_back(static_cast<int>(part.PDGID));
+    m_Charge.push_back(static_cast<short>(Charge(part.PDGID)));
+    m_Pt.push_back(static_cast<float>(part.GetPt()));
+    m_Y.push_back(static_cast<float>(part.GetY()));
+    m_Eta.push_back(static_cast<float>(part.GetEta()));
+    m_Phi.push_back(static_cast<float>(atan2(part.py, part.px)));
+    m_M.push_back(static_cast<float>(part.m));
+    if (m_Config.printCoordinates) {
+      m_R0.push_back(static_cast<float>(part.r0));
+      m_Rx.push_back(static_cast<float>(part.rx));
+      m_Ry.push_back(static_cast<float>(part.ry));
+      m_Rz.push_back(static_cast<float>(part.rz));
+    }
+    if (m_Config.printMotherPdg)
+      m_MotherPDG.push_back(static_cast<int>(part.MotherPDGID));
+    if (m_Config.printDecayEpoch)
+      m_Epoch.push_back(static_cast<short>(part.epoch));
+  }
+
+  bool RootEventWriter::WriteEvent(const SimpleEvent& evt)
+  {
+    if (m_Tree == NULL)
+      return false;
+
+    ++m_EventNumber;
+
+    m_PDG.clear();
+    m_Charge.clear();
+    m_Pt.clear();
+    m_Y.clear();
+    m_Eta.clear();
+    m_Phi.clear();
+    m_M.clear();
+    m_R0.clear();
+    m_Rx.clear();
+    m_Ry.clear();
+    m_Rz.clear();
+    m_MotherPDG.clear();
+    m_Epoch.clear();
+
+    for (size_t i = 0; i < evt.Particles.size(); ++i)
+      AddParticle(evt.Particles[i]);
+
+    if (m_Config.printPhotonsLeptons) {
+      for (size_t i = 0; i < evt.PhotonsLeptons.size(); ++i)
+        AddParticle(evt.PhotonsLeptons[i]);
+    }
+
+    m_Weight = evt.weight;
+    m_LogWeight = evt.logweight;
+
+#ifdef USE_ROOT_TREE
+    return m_Tree->Fill() >= 0;
+#else
+    return false;
+#endif
+  }
+
+} // namespace thermalfist
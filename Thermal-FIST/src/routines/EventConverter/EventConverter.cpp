@@ -0,0 +1,71 @@
+/*
+ * Thermal-FIST package
+ *
+ * Copyright (c) 2022 Volodymyr Vovchenko
+ *
+ * GNU General Public License (GPLv3 or later)
+ */
+#include <string>
+#include <iostream>
+#include <cstdlib>
+
+#include "HRGEventGenerator.h"
+
+#include "ThermalFISTConfig.h"
+
+using namespace std;
+
+#ifdef ThermalFIST_USENAMESPACE
+using namespace thermalfist;
+#endif
+
+// Converts the events stored in the binary format of BinaryEventWriter to one of the other formats
+// Usage: EventConverter <input file> <output file> <format> <max events>
+// Formats:
+// ascii    - EventWriter, the four-momenta only
+// extended - EventWriterAsciiExtended, all the columns stored in the binary file (default)
+// urqmd    - EventWriterForUrqmd
+// hepmc    - HepMCEventWriter
+int main(int argc, char *argv[])
+{
+  if (argc < 3) {
+    cout << "Usage: EventConverter <input file> <output file> [ascii|extended|urqmd|hepmc] [max events]" << endl;
+    return 1;
+  }
+
+  string inputfile = argv[1];
+  string outputfile = argv[2];
+
+  string format = "extended";
+  if (argc > 3)
+    format = argv[3];
+
+  long long maxevents = -1;
+  if (argc > 4)
+    maxevents = atoll(argv[4]);
+
+  BinaryEventReader reader(inputfile);
+  if (!reader.IsOpen())
+    return 1;
+
+  EventWriter *writer = NULL;
+  if (format == "ascii")
+    writer = new EventWriter(outputfile);
+  else if (format == "extended")
+    writer = new EventWriterAsciiExtended(outputfile, reader.OutputConfig());
+  else if (format == "urqmd")
+    writer = new EventWriterForUrqmd(outputfile);
+  else if (format == "hepmc")
+    writer = new HepMCEventWriter(outputfile);
+  else {
+    cerr << "**ERROR** EventConverter: Unknown output format " << format << endl;
+    return 1;
+  }
+
+  long long converted = reader.ConvertEvents(*writer, maxevents);
+  cout << "Converted " << converted << " events from " << inputfile << " to " << outputfile << " (" << format << ")" << endl;
+
+  delete writer;
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+// main283.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2025 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: utility;
+
+// This program illustrates how a binary snapshot of the settings and
+// particle data can be written once, and then be used to construct new
+// Pythia instances without parsing the xmldoc files. It checks that the
+// snapshot reproduces the XML initialization, and times both options.
+
+#include "Pythia8/Pythia.h"
+#include <chrono>
+using namespace Pythia8;
+
+//==========================================================================
+
+// Generate a few Z0 events, which exercise the hadronization and decays,
+// and collect their particle content in a string. Empty if init fails.
+
+string someEvents(Pythia& pythia) {
+  pythia.readString("Beams:idA = 11");
+  pythia.readString("Beams:idB = -11");
+  pythia.readString("Beams:eCM = 91.1876");
+  pythia.readString("WeakSingleBoson:ffbar2gmZ = on");
+  pythia.readString("Next:numberCount = 0");
+  pythia.readString("Next:numberShowInfo = 0");
+  pythia.readString("Next:numberShowProcess = 0");
+  pythia.readString("Next:numberShowEvent = 0");
+  if (!pythia.init()) return "";
+  ostringstream os;
+  os << setprecision(17);
+  for (int iEvent = 0; iEvent < 5; ++iEvent) {
+    if (!pythia.next()) continue;
+    for (int i = 0; i < pythia.event.size(); ++i)
+      os << pythia.event[i].id() << " " << pythia.event[i].p();
+  }
+  return os.str();
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of constructions to time, and snapshot file name.
+  int    nConstruct   = 20;
+  string snapshotFile = "main283.snapshot";
+
+  // Write the snapshot once, from a normally constructed instance.
+  {
+    Pythia pythia("../share/Pythia8/xmldoc", false);
+    if (!pythia.writeSnapshot(snapshotFile)) return 1;
+  }
+
+  // Construct one instance each way.
+  Pythia pythiaXML("../share/Pythia8/xmldoc", false);
+  ifstream is(snapshotFile.c_str(), ios::binary);
+  Pythia pythiaSnap(is, false);
+  is.close();
+
+  // Compare all settings and particle data, as written in plain text,
+  // and a new snapshot written from the snapshot-constructed instance.
+  ostringstream setXML, setSnap, pdXML, pdSnap, snapXML, snapSnap;
+  pythiaXML.settings.writeFile(setXML, true);
+  pythiaSnap.settings.writeFile(setSnap, true);
+  pythiaXML.particleData.listAll(pdXML);
+  pythiaSnap.particleData.listAll(pdSnap);
+  pythiaXML.writeSnapshot(snapXML);
+  pythiaSnap.writeSnapshot(snapSnap);
+  bool sameSettings  = setXML.str() == setSnap.str();
+  bool sameParticles = pdXML.str() == pdSnap.str();
+  bool sameSnapshot  = snapXML.str() == snapSnap.str();
+
+  // Compare some events generated with the two instances.
+  string eventsXML = someEvents(pythiaXML);
+  bool sameEvents = eventsXML != "" && eventsXML == someEvents(pythiaSnap);
+
+  // Time repeated construction from XML files or from the snapshot.
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < nConstruct; ++i)
+    Pythia pythia("../share/Pythia8/xmldoc", false);
+  auto middle = std::chrono::steady_clock::now();
+  for (int i = 0; i < nConstruct; ++i) {
+    ifstream isNow(snapshotFile.c_str(), ios::binary);
+    Pythia pythia(isNow, false);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double msXML  = std::chrono::duration<double, std::milli>(middle - start)
+    .count() / nConstruct;
+  double msSnap = std::chrono::duration<double, std::milli>(stop - middle)
+    .count() / nConstruct;
+
+  // Print the outcome.
+  cout << "\n Snapshot of " << snapXML.str().size() << " bytes compared "
+       << "with XML initialization:\n"
+       << "   settings identical:      " << toString(sameSettings) << "\n"
+       << "   particle data identical: " << toString(sameParticles) << "\n"
+       << "   snapshot round trip:     " << toString(sameSnapshot) << "\n"
+       << "   events identical:        " << toString(sameEvents) << "\n"
+       << fixed << setprecision(2)
+       << "\n Time per construction from XML files: " << setw(8) << msXML
+       << " ms\n Time per construction from snapshot:  " << setw(8) << msSnap
+       << " ms" << endl;
+
+  // Done.
+  return (sameSettings && sameParticles && sameSnapshot && sameEvents)
+    ? 0 : 1;
+}
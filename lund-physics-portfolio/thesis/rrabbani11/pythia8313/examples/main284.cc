@@ -0,0 +1,102 @@
+// main284.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2025 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: utility;
+
+// This program illustrates how a flag, mode or parm can be resolved once
+// into a handle, and then be read or changed without a lookup by name.
+// It checks that the handles give the same outcome as access by name,
+// also for changes with side effects, and times both options.
+
+#include "Pythia8/Pythia.h"
+#include <chrono>
+using namespace Pythia8;
+
+//==========================================================================
+
+// Time per call in ns of a loop body, repeated nLoop times.
+
+template<typename F> double nsPerCall(int nLoop, F body) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < nLoop; ++i) body(i);
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count()
+    / nLoop;
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of calls to time.
+  int nLoop = 2000000;
+
+  // Two instances, one to be changed by name and one through handles.
+  Pythia pythiaName("../share/Pythia8/xmldoc", false);
+  Pythia pythiaHandle("../share/Pythia8/xmldoc", false);
+  Settings& byName   = pythiaName.settings;
+  Settings& byHandle = pythiaHandle.settings;
+
+  // Resolve the handles once. An unknown key gives an invalid handle.
+  FlagHandle vertex = byHandle.flagHandle("PartonVertex:setVertex");
+  ModeHandle tune   = byHandle.modeHandle("Tune:pp");
+  ParmHandle aLund  = byHandle.parmHandle("StringZ:aLund");
+  ParmHandle bogus  = byHandle.parmHandle("No:suchParm");
+  bool validHandles = vertex.isValid() && tune.isValid() && aLund.isValid()
+    && !bogus.isValid();
+
+  // Change values both ways, including one outside the allowed range
+  // and a tune, which in its turn changes many other settings.
+  byName.flag("PartonVertex:setVertex", true);
+  byHandle.flag(vertex, true);
+  byName.parm("StringZ:aLund", -5.);
+  byHandle.parm(aLund, -5.);
+  byName.mode("Tune:pp", 7);
+  byHandle.mode(tune, 7);
+
+  // Compare the full settings listings, and reads by handle and by name.
+  ostringstream setName, setHandle;
+  byName.writeFile(setName, true);
+  byHandle.writeFile(setHandle, true);
+  bool sameSettings = setName.str() == setHandle.str();
+  bool sameReads
+    =  byHandle.flag(vertex) == byName.flag("PartonVertex:setVertex")
+    && byHandle.mode(tune)   == byName.mode("Tune:pp")
+    && byHandle.parm(aLund)  == byName.parm("StringZ:aLund");
+
+  // Time reads and writes by name and through handles.
+  double sum = 0.;
+  double nsFlagName   = nsPerCall(nLoop, [&](int) {
+    sum += byHandle.flag("PartonVertex:setVertex"); });
+  double nsFlagHandle = nsPerCall(nLoop, [&](int) {
+    sum += byHandle.flag(vertex); });
+  double nsParmName   = nsPerCall(nLoop, [&](int) {
+    sum += byHandle.parm("StringZ:aLund"); });
+  double nsParmHandle = nsPerCall(nLoop, [&](int) {
+    sum += byHandle.parm(aLund); });
+  double nsSetName    = nsPerCall(nLoop, [&](int i) {
+    byHandle.parm("StringZ:aLund", 0.68 + 1e-9 * (i % 7)); });
+  double nsSetHandle  = nsPerCall(nLoop, [&](int i) {
+    byHandle.parm(aLund, 0.68 + 1e-9 * (i % 7)); });
+
+  // Print the outcome. The sum only keeps the reads from being optimized
+  // away.
+  cout << "\n Settings changed through handles compared with by name:\n"
+       << "   handles resolved as expected: " << toString(validHandles) << "\n"
+       << "   settings identical:           " << toString(sameSettings) << "\n"
+       << "   reads identical:              " << toString(sameReads) << "\n"
+       << fixed << setprecision(2)
+       << "\n Time per call in ns:      by name    by handle\n"
+       << "   flag read            " << setw(10) << nsFlagName
+       << setw(13) << nsFlagHandle << "\n"
+       << "   parm read            " << setw(10) << nsParmName
+       << setw(13) << nsParmHandle << "\n"
+       << "   parm write           " << setw(10) << nsSetName
+       << setw(13) << nsSetHandle << "\n"
+       << "\n (checksum " << setprecision(1) << sum << ")" << endl;
+
+  // Done.
+  return (validHandles && sameSettings && sameReads) ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+// main285.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2025 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: utility;
+
+// This program times the lookup of particle properties by id in the
+// ParticleData database, over the particle content of some Z0 events.
+// It checks that each lookup finds the same entry as a search of the
+// ordered table, also after particles have been added, and compares the
+// time per call with a plain std::map lookup.
+
+#include "Pythia8/Pythia.h"
+#include <chrono>
+using namespace Pythia8;
+
+//==========================================================================
+
+// Check that findParticle gives the entry stored in the ordered table for
+// all particles and antiparticles, and nothing for unknown ids. The
+// entry for id 0 is a placeholder, which is never found.
+
+bool sameEntries(ParticleData& pd) {
+  for (auto pde = pd.begin(); pde != pd.end(); ++pde) {
+    int id = pde->first;
+    if (id == 0) continue;
+    if (pd.findParticle(id) != pde->second) return false;
+    bool hasAnti = pde->second->hasAnti();
+    if ((pd.findParticle(-id) == pde->second) != hasAnti) return false;
+    if (pd.isParticle(-id) != hasAnti) return false;
+  }
+  return !pd.isParticle(0) && !pd.isParticle(987654321);
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of events, and number of passes over their particle ids.
+  int nEvent = 1000;
+  int nPass  = 50;
+
+  // Generate Z0 events, and collect the ids of all particles in them.
+  Pythia pythia("../share/Pythia8/xmldoc");
+  pythia.readString("Beams:idA = 11");
+  pythia.readString("Beams:idB = -11");
+  pythia.readString("Beams:eCM = 91.1876");
+  pythia.readString("WeakSingleBoson:ffbar2gmZ = on");
+  pythia.readString("Next:numberCount = 0");
+  if (!pythia.init()) return 1;
+  vector<int> ids;
+  for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+    if (!pythia.next()) continue;
+    for (int i = 0; i < pythia.event.size(); ++i)
+      ids.push_back(pythia.event[i].id());
+  }
+
+  // Check the lookup, before and after new particles are added.
+  ParticleData& pd = pythia.particleData;
+  bool sameBefore = sameEntries(pd);
+  for (int id = 9900001; id <= 9900200; ++id)
+    pd.addParticle(id, "dummy", "dummybar", 1, 0, 0, 100. + 0.1 * id);
+  bool sameAfter = sameEntries(pd) && pd.m0(9900200) > 100.;
+
+  // The same entries in a plain std::map, for comparison.
+  map<int, ParticleDataEntryPtr> pdtCopy(pd.begin(), pd.end());
+
+  // Time property lookups over the particle ids, six calls per id.
+  double sumPD = 0.;
+  auto start = std::chrono::steady_clock::now();
+  for (int iPass = 0; iPass < nPass; ++iPass)
+  for (int id : ids) {
+    if (pd.isParticle(id)) sumPD += pd.m0(id) + pd.charge(id)
+      + (pd.isHadron(id) ? 1. : 0.) + pd.mWidth(id) + pd.tau0(id);
+  }
+  auto middle = std::chrono::steady_clock::now();
+  double sumMap = 0.;
+  for (int iPass = 0; iPass < nPass; ++iPass)
+  for (int id : ids)
+  for (int iCall = 0; iCall < 6; ++iCall) {
+    auto pde = pdtCopy.find(abs(id));
+    if (pde != pdtCopy.end()) sumMap += pde->second->m0();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double nCall = 6. * nPass * ids.size();
+  double nsPD  = std::chrono::duration<double, std::nano>(middle - start)
+    .count() / nCall;
+  double nsMap = std::chrono::duration<double, std::nano>(stop - middle)
+    .count() / nCall;
+
+  // Print the outcome. The sums only keep the loops from being optimized
+  // away.
+  cout << "\n Particle data lookup for " << ids.size() << " particle ids:\n"
+       << "   entries found before additions: " << toString(sameBefore)
+       << "\n   entries found after additions:  " << toString(sameAfter)
+       << fixed << setprecision(2)
+       << "\n\n Time per ParticleData call:      " << setw(8) << nsPD
+       << " ns\n Time per plain std::map lookup:  " << setw(8) << nsMap
+       << " ns\n\n (checksums " << scientific << setprecision(6) << sumPD
+       << " " << sumMap << ")" << endl;
+
+  // Done.
+  return (sameBefore && sameAfter) ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+// main286.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2025 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: colour reconnection; utility;
+
+// This program studies how the time spent in the QCD-based colour
+// reconnection (mode 1) grows with the number of partons. Parton-level
+// pp events are stacked k at a time, and the colour reconnection alone
+// is then run on each stacked event by forceHadronLevel, with the
+// hadronization and decays switched off.
+
+#include "Pythia8/Pythia.h"
+#include <chrono>
+using namespace Pythia8;
+
+//==========================================================================
+
+int main() {
+
+  // Number of stacked events per point, and largest number of events
+  // stacked together.
+  int nSample = 10;
+  int nStackMax = 16;
+
+  // Parton-level pp events. The colour reconnection is only done in
+  // forceHadronLevel, where hadronization and decays are off.
+  Pythia pythia("../share/Pythia8/xmldoc");
+  pythia.readString("Beams:eCM = 13000.");
+  pythia.readString("SoftQCD:nonDiffractive = on");
+  pythia.readString("ColourReconnection:mode = 1");
+  pythia.readString("ColourReconnection:reconnect = off");
+  pythia.readString("ColourReconnection:forceHadronLevelCR = on");
+  pythia.readString("HadronLevel:all = off");
+  pythia.readString("HadronLevel:Hadronize = off");
+  pythia.readString("HadronLevel:Decay = off");
+  pythia.readString("Check:event = off");
+  pythia.readString("Next:numberCount = 0");
+  pythia.readString("Next:numberShowInfo = 0");
+  pythia.readString("Next:numberShowProcess = 0");
+  pythia.readString("Next:numberShowEvent = 0");
+  if (!pythia.init()) return 1;
+
+  // Loop over the number of events stacked together.
+  cout << "\n  stacked     partons     ms/event    growth exponent\n";
+  double nPartonLast = 0., msLast = 0.;
+  int nFail = 0;
+  for (int nStack = 1; nStack <= nStackMax; nStack *= 2) {
+    double nPartonSum = 0., msSum = 0.;
+    for (int iSample = 0; iSample < nSample; ++iSample) {
+
+      // Stack the parton-level events.
+      Event stacked;
+      for (int iStack = 0; iStack < nStack; ++iStack) {
+        while (!pythia.next()) ;
+        if (iStack == 0) stacked = pythia.event;
+        else stacked += pythia.event;
+      }
+      for (int i = 0; i < stacked.size(); ++i)
+        if (stacked[i].isFinal() && (stacked[i].col() || stacked[i].acol()))
+          nPartonSum += 1.;
+
+      // Time the colour reconnection of the stacked event.
+      pythia.event = stacked;
+      auto start = std::chrono::steady_clock::now();
+      if (!pythia.forceHadronLevel(false)) ++nFail;
+      auto stop = std::chrono::steady_clock::now();
+      msSum += std::chrono::duration<double, std::milli>(stop - start)
+        .count();
+    }
+
+    // Print average time, and local exponent of its growth with partons.
+    double nParton = nPartonSum / nSample;
+    double ms      = msSum / nSample;
+    cout << fixed << setprecision(1) << setw(9) << nStack << setw(12)
+         << nParton << setprecision(3) << setw(13) << ms;
+    if (nStack > 1) cout << setprecision(2) << setw(19)
+      << log(ms / msLast) / log(nParton / nPartonLast);
+    cout << "\n";
+    nPartonLast = nParton;
+    msLast      = ms;
+  }
+
+  // Done. All reconnected events should be colour consistent.
+  cout << "\n Number of failed colour reconnections: " << nFail << endl;
+  return (nFail == 0) ? 0 : 1;
+}
@@ -65,7 +65,7 @@ private:
 
   // Constants: could only be changed in the code itself.
   static const int    IDHADRON[9], ITABLE[9], NCOMPSTEP;
-  static const double STEPSIZE, Q2MIN, COMPRELERR, COMPFACMAX;
+  static const double STEPSIZE, Q2MIN, COMPRELERR, COMPFACMAX, EXPMAX;
 
   // Initialization data, read from Settings.
   bool   doPion, doKaon, doEta;
@@ -294,6 +294,17 @@ private:
   void singleJunction(const ColourDipolePtr& dip1, const ColourDipolePtr& dip2,
     const ColourDipolePtr& dip3);
 
+  // Try all three-dipole junctions with dip1 as first leg and the other
+  // two legs taken from dips, starting at position iBeg.
+  void tripleJunctions(const ColourDipolePtr& dip1,
+    const vector<ColourDipolePtr>& dips, int iBeg = 0);
+
+  // Check whether a dipole can be a leg of a three-dipole junction.
+  bool isJunctionLeg(const ColourDipolePtr& dip) const;
+
+  // Merge the unsorted trials from position nOld into the sorted list.
+  void mergeTrials(vector<TrialReconnection>& trials, int nOld);
+
   // Print the chain containing the dipole.
   void listChain(ColourDipolePtr& dip);
 
@@ -25,7 +25,9 @@ public:
 
   // Constructor.
   DeuteronProduction() : valid(true), models(), ids(), parms(), masses(),
-    norm(), mPion(), mSafety(), kMin(), kMax(), kTol(), kSteps() {}
+    norm(), mPion(), mSafety(), kMin(), kMax(), kTol(), kSteps(), dkBin(),
+    dlogkBin(), binnedMaxima(), sigmaBins(), cacheKeys(), cacheK(),
+    cacheS() {}
 
   // Find settings. Precalculate table used to find momentum shifts.
   bool init();
@@ -44,9 +46,20 @@ private:
   double mSafety;                        // Safety margin for decays.
   double kMin, kMax, kTol;               // Bracketing/tolerance in k for max.
   int kSteps;                            // Number of steps for grid search.
+  double dkBin, dlogkBin;                // Width of the (log) bins in k.
+  bool binnedMaxima;                     // Pre-reject with the k bin maxima.
+  vector<vector<double> > sigmaBins;     // Cross-section maxima per k bin.
+
+  // Channel maxima cached between initializations.
+  vector<vector<double> > cacheKeys;     // Inputs to each cached channel.
+  vector<double> cacheK, cacheS;         // Location and value of maximum.
 
   // Constants: could only be changed in the code itself.
   static const int NTRYDECAY;           // Number of times to try a decay.
+  static const int NKBINS, NKLOGBINS;   // Number of linear and log k bins.
+  static const int NKSUB;               // Number of samples per k bin.
+  static const double KLOGMAX;          // Upper end of log k bins / kMax.
+  static const double SIGMAMARGIN;      // Safety margin on binned maxima.
   static const double WTCORRECTION[11]; // M-generator parameters.
 
   // Bind the nucleon-pair combinations.
@@ -66,6 +79,7 @@ private:
 
   // Helper methods.
   void maximum(double& k, double& s, int chn); // Find cross-section max.
+  void binMaxima(int chn);                     // Find maxima in k bins.
   vector<int> parseIds(string line);           // Parse the ID strings.
   vector<double> parseParms(string line);      // Parse the parameter strings.
 
@@ -79,6 +79,36 @@ public:
 
 //==========================================================================
 
+// The FragParContainer class is a simple container for the fragmentation
+// parameters that may be changed between string breaks, e.g. by rope
+// hadronization. It allows StringFlav, StringZ and StringPT to be updated
+// directly, without storing the values in the Settings database and
+// re-reading all parameters in init().
+// sigma = StringPT:sigma.
+// aLund, bLund, aExtraDiquark = StringZ:aLund, :bLund, :aExtraDiquark.
+// probStoUD, probSQtoQQ, probQQ1toQQ0, probQQtoQ = the StringFlav ones.
+
+class FragParContainer {
+
+public:
+
+  // Constructor.
+  FragParContainer(double sigmaIn = 0., double aLundIn = 0.,
+    double bLundIn = 0., double aExtraDiquarkIn = 0.,
+    double probStoUDIn = 0., double probSQtoQQIn = 0.,
+    double probQQ1toQQ0In = 0., double probQQtoQIn = 0.) : sigma(sigmaIn),
+    aLund(aLundIn), bLund(bLundIn), aExtraDiquark(aExtraDiquarkIn),
+    probStoUD(probStoUDIn), probSQtoQQ(probSQtoQQIn),
+    probQQ1toQQ0(probQQ1toQQ0In), probQQtoQ(probQQtoQIn) {}
+
+  // Stored properties.
+  double sigma, aLund, bLund, aExtraDiquark, probStoUD, probSQtoQQ,
+         probQQ1toQQ0, probQQtoQ;
+
+};
+
+//==========================================================================
+
 // The StringFlav class is used to select quark and hadron flavours.
 
 class StringFlav : public PhysicsBase {
@@ -113,6 +143,9 @@ public:
   virtual void init(double kappaModifier, double strangeJunc,
     double probQQmod);
 
+  // Change the string-break parameters directly, without Settings.
+  virtual void setFragPars(const FragParContainer& fragPars);
+
   // Pick a light d, u or s quark according to fixed ratios.
   int pickLightQ() { double rndmFlav = probQandS * rndmPtr->flat();
     if (rndmFlav < 1.) return 1;
@@ -279,6 +312,11 @@ public:
   // Initialize data members.
   virtual void init();
 
+  // Change the fragmentation function parameters directly.
+  virtual void setFragPars(const FragParContainer& fragPars) {
+    aLund = fragPars.aLund; bLund = fragPars.bLund;
+    aExtraDiquark = fragPars.aExtraDiquark;}
+
   // Fragmentation function: top-level to determine parameters.
   virtual double zFrag( int idOld, int idNew = 0, double mT2 = 1.);
 
@@ -339,6 +377,11 @@ public:
   // Initialize data members.
   virtual void init();
 
+  // Change the pT width directly.
+  virtual void setFragPars(const FragParContainer& fragPars) {
+    sigmaQ = fragPars.sigma / sqrt(2.);
+    sigma2Had = 2. * pow2( max( SIGMAMIN, fragPars.sigma) );}
+
   // General function, return px and py as a pair in the same call
   // in either model.
   pair<double, double>  pxy(int idIn, double kappaModifier = -1.0) {
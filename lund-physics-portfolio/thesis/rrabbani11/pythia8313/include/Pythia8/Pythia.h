@@ -84,6 +84,10 @@ public:
   Pythia( istream& settingsStrings, istream& particleDataStrings,
     bool printBanner = true);
 
+  // Constructor from a binary snapshot of the settings and particle
+  // databases, as written by writeSnapshot (to speed up construction).
+  Pythia( istream& snapshot, bool printBanner = true);
+
   // Destructor.
   ~Pythia() {}
 
@@ -110,6 +114,10 @@ public:
   bool readFile(istream& is, int subrun) {
     return readFile(is, true, subrun);}
 
+  // Write a binary snapshot of the settings and particle databases.
+  bool writeSnapshot(string fileName);
+  bool writeSnapshot(ostream& os);
+
   // Possibility to pass in pointers to PDF's.
   bool setPDFPtr( PDFPtr pdfAPtrIn, PDFPtr pdfBPtrIn,
     PDFPtr pdfHardAPtrIn = nullptr, PDFPtr pdfHardBPtrIn = nullptr,
@@ -449,6 +457,8 @@ private:
 
   // Constants: could only be changed in the code itself.
   static const double VERSIONNUMBERHEAD, VERSIONNUMBERCODE;
+  // Tag at the start of a binary snapshot of the databases.
+  static const string SNAPSHOTTAG;
   // Maximum number of tries to produce parton level from given input.
   // Negative integer to denote that no subrun has been set.
   static const int    NTRY = 10;
@@ -19,6 +19,7 @@
 #include <functional>
 #include <limits>
 #include <utility>
+#include <type_traits>
 
 // Stdlib header files for strings and containers.
 #include <string>
@@ -222,6 +223,63 @@ inline string toString(int val) {return to_string(val);}
 // Convert a double to a string.
 string toString(double val);
 
+// Write a number, string, vector or map to a binary stream, as used for
+// snapshots of the databases. Strings and containers are preceded by
+// their size. Further types are handled by overloads in their own files.
+template<typename T> inline typename std::enable_if<
+  std::is_arithmetic<T>::value>::type writeBinary(ostream& os, const T& val) {
+  os.write( reinterpret_cast<const char*>(&val), sizeof(T));}
+inline void writeBinary(ostream& os, const string& val) {
+  writeBinary( os, val.size()); os.write( val.data(), val.size());}
+template<typename T> inline void writeBinary(ostream& os,
+  const vector<T>& val) { writeBinary( os, val.size());
+  for (size_t i = 0; i < val.size(); ++i) writeBinary( os, T(val[i]));}
+template<typename K, typename T> inline void writeBinary(ostream& os,
+  const map<K,T>& val) { writeBinary( os, val.size());
+  for (const auto& entry : val) {
+    writeBinary( os, entry.first); writeBinary( os, entry.second);} }
+
+// Read back what was written with writeBinary. Return false on failure.
+template<typename T> inline typename std::enable_if<
+  std::is_arithmetic<T>::value, bool>::type readBinary(istream& is, T& val) {
+  return bool(is.read( reinterpret_cast<char*>(&val), sizeof(T)));}
+// Strings are read in bounded chunks, so that a corrupted size only
+// gives a failure at the end of the stream, not a huge allocation.
+inline bool readBinary(istream& is, string& val) {
+  size_t n = 0;
+  if (!readBinary( is, n)) return false;
+  val.clear();
+  char buffer[4096];
+  while (n > 0) {
+    size_t nNow = min( n, sizeof(buffer));
+    if (!is.read( buffer, nNow)) return false;
+    val.append( buffer, nNow);
+    n -= nNow;
+  }
+  return true;}
+template<typename T> inline bool readBinary(istream& is, vector<T>& val) {
+  size_t n = 0;
+  if (!readBinary( is, n)) return false;
+  val.clear();
+  for (size_t i = 0; i < n; ++i) {
+    T tmp;
+    if (!readBinary( is, tmp)) return false;
+    val.push_back(tmp);
+  }
+  return true;}
+template<typename K, typename T> inline bool readBinary(istream& is,
+  map<K,T>& val) {
+  size_t n = 0;
+  if (!readBinary( is, n)) return false;
+  val.clear();
+  for (size_t i = 0; i < n; ++i) {
+    K key;
+    T tmp;
+    if (!readBinary( is, key) || !readBinary( is, tmp)) return false;
+    val.insert( val.end(), make_pair( key, tmp));
+  }
+  return true;}
+
 //==========================================================================
 
 // Print a method name using the appropriate pre-processor macro.
@@ -17,6 +17,7 @@
 
 #include "Pythia8/Basics.h"
 #include "Pythia8/Event.h"
+#include "Pythia8/FragmentationFlavZpT.h"
 #include "Pythia8/FragmentationSystems.h"
 #include "Pythia8/Info.h"
 #include "Pythia8/ParticleData.h"
@@ -119,6 +120,8 @@ public:
   // Get the rotation matrix to go to dipole rest frame.
   RotBstMatrix getDipoleRestFrame();
   RotBstMatrix getDipoleLabFrame();
+  // Test if the rest frame is already fixed.
+  bool hasRestFrame() { return hasRotTo; }
 
   // Get the dipole momentum four-vector.
   Vec4 dipoleMomentum();
@@ -217,7 +220,7 @@ public:
     shoveJunctionStrings(),
     shoveMiniStrings(), shoveGluonLoops(), mStringMin(), limitMom(), rCutOff(),
     gAmplitude(), gExponent(), deltay(), deltat(), tShove(), tInit(),
-    showerCut(), alwaysHighest() {}
+    showerCut(), alwaysHighest(), indexOverlaps(), indexShoving() {}
 
   // The Ropewalk init function sets parameters and pointers.
   virtual bool init();
@@ -250,6 +253,18 @@ public:
 
 private:
 
+  // Constants: could only be changed in the code itself.
+  static const double OVERLAPNCELLMAX, SHOVECELLWIDTH;
+
+  // Shove the excitations in all rapidity slices, only considering
+  // pairs that can be closer than the cut-off radius.
+  void shoveIndexed(const vector<double>& rapidities,
+    vector< vector<RopeDipole*> >& sliceDipoles);
+
+  // Shove the excitations in rapidity slice i at y for one time step,
+  // with string radius rt.
+  void shoveSlice(int i, double y, double rt, vector<RopeDipole*>& tmp);
+
   // Parameters of the ropewalk.
   double r0, m0, pTcut;
   // Include junction strings in shoving.
@@ -278,6 +293,10 @@ private:
   double showerCut;
   // Assume we are always in highest multiplet.
   bool alwaysHighest;
+  // Use a transverse grid to find overlapping dipoles.
+  bool indexOverlaps;
+  // Use a transverse grid to find shoving excitations.
+  bool indexShoving;
 
   // All dipoles in the event sorted by event record.
   // Index of the two partons.
@@ -299,7 +318,9 @@ private:
 //==================================================================
 
 // RopeFragPars recalculates fragmentation parameters according to a
-// changed string tension. Helper class to FlavourRope.
+// changed string tension. Helper class to FlavourRope. The parameters
+// are tabulated at initialization on a grid in the string tension,
+// and interpolated linearly in between.
 
 class RopeFragPars : public PhysicsBase {
 
@@ -309,7 +330,8 @@ public:
   RopeFragPars() : aIn(), adiqIn(), bIn(), rhoIn(), xIn(),
     yIn(), xiIn(), sigmaIn(), kappaIn(), aEff(), adiqEff(), bEff(),
     rhoEff(), xEff(), yEff(), xiEff(), sigmaEff(), kappaEff(),
-    beta() {}
+    beta(), tolerance(), hMax(), dh(), hasLast(false), hLast(),
+    fragParsLast() {}
 
   // The init function sets up initial parameters from settings.
   bool init();
@@ -318,19 +340,31 @@ public:
   // name for easy insertion in settings.
   map<string,double> getEffectiveParameters(double h);
 
+  // Return the same parameters, except the string tension, in a
+  // container that can be passed directly to the fragmentation selectors.
+  FragParContainer getEffectiveFragPars(double h);
+
+  // Grid spacing and number of points of the table; zero if not used.
+  double tableSpacing() const { return dh;}
+  int tableSize() const { return int(table.size());}
+
 private:
 
   // Constants: can only be changed in the code itself.
-  static const double DELTAA, ACONV, ZCUT;
+  static const double DELTAA, ACONV, ZCUT, DHMAX, DHMIN;
 
-  // Get the Fragmentation function a parameter from cache or calculate it.
+  // Calculate the Fragmentation function a parameter.
   double getEffectiveA(double thisb, double mT2, bool isDiquark);
 
   // Calculate the effective parameters.
   bool calculateEffectiveParameters(double h);
 
-  // Insert calculated parameters in cache for later (re-)use.
-  bool insertEffectiveParameters(double h);
+  // Calculate the effective parameters and return them in a container.
+  FragParContainer calculateFragPars(double h);
+
+  // Set up the table with the largest grid spacing that meets
+  // the required tolerance.
+  void initTable();
 
   // Calculate the a parameter.
   double aEffective(double aOrig, double thisb, double mT2);
@@ -344,15 +378,6 @@ private:
   // Helper function for integration.
   double trapIntegrate(double a, double b, double mT2, double sOld, int n);
 
-  // Parameter caches to re-use calculations. Sets of parameters, ordered in h.
-  map<double, map<string, double> > parameters;
-
-  // Values of the a-parameter ordered in b*mT2 grid.
-  map<double, double> aMap;
-
-  // The same for aDiquark.
-  map<double, double> aDiqMap;
-
   // Initial values of parameters.
   double aIn, adiqIn, bIn, rhoIn, xIn, yIn, xiIn, sigmaIn, kappaIn;
 
@@ -362,6 +387,15 @@ private:
   // Junction parameter.
   double beta;
 
+  // Table of parameters at h = 1 + i * dh, for h up to hMax.
+  double tolerance, hMax, dh;
+  vector<FragParContainer> table;
+
+  // Last parameters calculated outside the table, e.g. for a fixed kappa.
+  bool hasLast;
+  double hLast;
+  FragParContainer fragParsLast;
+
 };
 
 //==================================================================
@@ -377,7 +411,8 @@ public:
 
   // Constructor.
   FlavourRope(Ropewalk & rwIn) : rwPtr(&rwIn), ePtr(), doBuffon(),
-              rapiditySpan(), stringProtonRatio(), fixedKappa(), h() {}
+              rapiditySpan(), stringProtonRatio(), fixedKappa(),
+              directFragPars(), useVertices(), kappaInit(), h() {}
 
   // Initialize. Set pointers.
   virtual bool init() override {
@@ -389,6 +424,13 @@ public:
     doBuffon = flag("Ropewalk:doBuffon");
     rapiditySpan = parm("Ropewalk:rapiditySpan");
     stringProtonRatio = parm("Ropewalk:stringProtonRatio");
+    // Pass parameters directly to the selectors, unless bLund is derived
+    // from other parameters in StringZ::init().
+    directFragPars = flag("Ropewalk:directFragPars")
+      && !flag("StringZ:deriveBLund");
+    // Dipole overlaps are calculated for each event if vertices are set.
+    useVertices = flag("PartonVertex:setVertex") && !doBuffon;
+    initFragParsNow();
     // Initialize FragPar.
     fp.init();
     return true;
@@ -416,14 +458,20 @@ protected:
 
 private:
 
-  // Find breakup placement and fetch effective parameters.
+  // Find breakup placement and fetch effective string tension.
   // For model depending on vertex information.
-  map<string, double> fetchParameters(double m2Had, vector<int> iParton,
+  double fetchEnhancement(double m2Had, const vector<int>& iParton,
     int endId);
   // For simple Buffon model.
-  map<string, double> fetchParametersBuffon(double m2Had, vector<int> iParton,
+  double fetchEnhancementBuffon(double m2Had, vector<int> iParton,
     int endId);
 
+  // Store the current parameter values and handles to their settings.
+  void initFragParsNow();
+
+  // Accept a new parameter value only if inside its allowed range.
+  void setInRange(int iPar, double valNew, double& valNow);
+
   // Pointer to the ropewalk object.
   Ropewalk* rwPtr;
 
@@ -445,6 +493,22 @@ private:
   // Use preset kappa from settings.
   bool fixedKappa;
 
+  // Pass parameters to the selectors directly rather than via Settings.
+  bool directFragPars;
+
+  // Calculate dipole overlaps from the vertex information in each event.
+  bool useVertices;
+
+  // Parameters currently used by the selectors, and handles to the
+  // corresponding settings, which also give their allowed ranges.
+  static const int NFRAGPARS = 8;
+  static const string FRAGPARNAMES[NFRAGPARS];
+  FragParContainer fragParsNow;
+  ParmHandle fragParHandles[NFRAGPARS], kappaHandle;
+
+  // Original value of StringFlav:kappa, scaled when not passed directly.
+  double kappaInit;
+
   // Locally stored string tension.
   double h;
 
@@ -12,6 +12,7 @@
 // MVec: vector of Modes (integers).
 // PVec: vector of Parms (doubles).
 // WVec: vector of Words (strings).
+// SettingHandle: direct access to a Flag, Mode or Parm.
 // Settings: maps of flags, modes, parms and words with input/output.
 
 #ifndef Pythia8_Settings_H
@@ -189,6 +190,44 @@ public:
 
 //==========================================================================
 
+// Handle to a flag, mode or parm, obtained from Settings::flagHandle etc.
+// It is resolved once by name, and can then be read or changed through
+// the Settings methods in constant time, without string operations.
+// It remains valid as long as the Settings object it came from, unless
+// the database is replaced by reInit or readSnapshot.
+
+template<typename T> class SettingHandle {
+
+public:
+
+  // Constructor. The default handle is invalid.
+  SettingHandle() : entryPtr(nullptr), hasSideEffects(false) {}
+
+  // Check whether the handle refers to an existing entry.
+  bool isValid() const {return entryPtr != nullptr;}
+
+  // The full entry, e.g. to read the limits, or nullptr if invalid.
+  const T* entry() const {return entryPtr;}
+
+private:
+
+  // Only Settings can create valid handles.
+  friend class Settings;
+  SettingHandle(T* entryPtrIn, bool hasSideEffectsIn) :
+    entryPtr(entryPtrIn), hasSideEffects(hasSideEffectsIn) {}
+
+  // The entry, and whether a change triggers further changes.
+  T*   entryPtr;
+  bool hasSideEffects;
+
+};
+
+typedef SettingHandle<Flag> FlagHandle;
+typedef SettingHandle<Mode> ModeHandle;
+typedef SettingHandle<Parm> ParmHandle;
+
+//==========================================================================
+
 // This class holds info on flags (bool), modes (int), parms (double),
 // words (string), fvecs (vector of bool), mvecs (vector of int),
 // pvecs (vector of double) and wvecs (vector of string).
@@ -237,6 +276,10 @@ public:
   bool writeFile(ostream& os = cout, bool writeAll = false) ;
   bool writeFileXML(ostream& os = cout) ;
 
+  // Write or read back the whole database in a compact binary format.
+  bool writeSnapshot(ostream& os);
+  bool readSnapshot(istream& is);
+
   // Print out table of database, either all or only changed ones,
   // or ones containing a given string.
   void listAll() { list( true, false, " "); }
@@ -346,6 +389,27 @@ public:
   void forceMVec(string keyIn, vector<int> nowIn) {mvec(keyIn,nowIn,true);}
   void forcePVec(string keyIn, vector<double> nowIn) {pvec(keyIn,nowIn,true);}
 
+  // Resolve a flag, mode or parm once into a handle, for fast repeated
+  // access. An unknown key gives an invalid handle, and an error.
+  FlagHandle flagHandle(string keyIn);
+  ModeHandle modeHandle(string keyIn);
+  ParmHandle parmHandle(string keyIn);
+
+  // Give back current value through a handle. An invalid handle gives
+  // the same value as an unknown key, but without a new error.
+  bool   flag(const FlagHandle& handle) const {
+    return handle.entryPtr ? handle.entryPtr->valNow : false;}
+  int    mode(const ModeHandle& handle) const {
+    return handle.entryPtr ? handle.entryPtr->valNow : 0;}
+  double parm(const ParmHandle& handle) const {
+    return handle.entryPtr ? handle.entryPtr->valNow : 0.;}
+
+  // Change current value through a handle, respecting limits.
+  // Changes that trigger further changes, like tunes, work as above.
+  void flag(const FlagHandle& handle, bool nowIn);
+  bool mode(const ModeHandle& handle, int nowIn, bool force = false);
+  bool parm(const ParmHandle& handle, double nowIn, bool force = false);
+
   // Restore current value to default.
   void resetFlag(string keyIn);
   void resetMode(string keyIn);
@@ -35,6 +35,9 @@ const double BoseEinstein::COMPRELERR = 1e-10;
 const double BoseEinstein::COMPFACMAX = 1000.;
 const int    BoseEinstein::NCOMPSTEP  = 10;
 
+// Beyond this exponent exp(-x) no longer changes 1 - exp(-x) in doubles.
+const double BoseEinstein::EXPMAX     = 40.;
+
 //--------------------------------------------------------------------------
 
 // Find settings. Precalculate table used to find momentum shifts.
@@ -223,8 +226,9 @@ void BoseEinstein::shiftPair( int i1, int i2, int iTab) {
   double Q2new = Q2old * pow( Qold / (Qold + 3. * lambda * Qmove), 2. / 3.);
 
   // Calculate corresponding three-momentum shift.
+  Vec4   p12       = hadronBE[i1].p - hadronBE[i2].p;
   double Q2Diff    = Q2new - Q2old;
-  double p2DiffAbs = (hadronBE[i1].p - hadronBE[i2].p).pAbs2();
+  double p2DiffAbs = p12.pAbs2();
   double p2AbsDiff = hadronBE[i1].p.pAbs2() - hadronBE[i2].p.pAbs2();
   double eSum      = hadronBE[i1].p.e() + hadronBE[i2].p.e();
   double eDiff     = hadronBE[i1].p.e() - hadronBE[i2].p.e();
@@ -235,7 +239,7 @@ void BoseEinstein::shiftPair( int i1, int i2, int iTab) {
     + Q2Diff * (sumQ2E - eDiff * eDiff) * rootB) ) / rootB;
 
   // Add shifts to sum. (Energy component dummy.)
-  Vec4   pDiff     = factor * (hadronBE[i1].p - hadronBE[i2].p);
+  Vec4   pDiff     = factor * p12;
   hadronBE[i1].pShift += pDiff;
   hadronBE[i2].pShift -= pDiff;
 
@@ -262,10 +266,10 @@ void BoseEinstein::shiftPair( int i1, int i2, int iTab) {
     + Q2Diff * (sumQ2E - eDiff * eDiff) * rootB) ) / rootB;
 
   // Extra dampening factor to go from BE_3 to BE_32.
-  factor   *= 1. - exp(-Q2old * R2Ref2);
+  if (Q2old * R2Ref2 < EXPMAX) factor *= 1. - exp(-Q2old * R2Ref2);
 
   // Add shifts to sum. (Energy component dummy.)
-  pDiff     = factor * (hadronBE[i1].p - hadronBE[i2].p);
+  pDiff     = factor * p12;
   hadronBE[i1].pComp += pDiff;
   hadronBE[i2].pComp -= pDiff;
 
@@ -297,6 +297,7 @@ bool ColourReconnection::nextNew( Event& event, int iFirst) {
     for (int j = 0; j < int(iDips[i].size()); ++j)
       for (int k = j + 1; k < int(iDips[i].size()); ++k)
         singleReconnection(dipoles[iDips[i][j]], dipoles[iDips[i][k]]);
+  mergeTrials(dipTrials, 0);
 
   // Only do warning once per event.
   bool alreadyWarned = false;
@@ -340,32 +341,24 @@ bool ColourReconnection::nextNew( Event& event, int iFirst) {
     if (allowJunctions) {
 
       // Split dipoles into three categories.
-      iDips.clear();
-      iDips.resize(3);
-      for (int i = 0; i < int(iDips.size()); ++i)
-        iDips[i] = vector<int>();
-
+      vector<vector<ColourDipolePtr> > junDips(3);
       for (int i = 0; i < int(dipoles.size()); ++i)
         if (dipoles[i]->isActive && !(dipoles[i]->isJun
             || dipoles[i]->isAntiJun))
-          iDips[dipoles[i]->colReconnection % 3].push_back(i);
+          junDips[dipoles[i]->colReconnection % 3].push_back(dipoles[i]);
 
       // Loop over different "colours" (now only three different groups).
-      for (int i = 0;i < int(iDips.size()); ++i)
-        for (int j = 0; j < int(iDips[i].size()); ++j)
-          for (int k = j + 1; k < int(iDips[i].size()); ++k)
-            singleJunction(dipoles[iDips[i][j]], dipoles[iDips[i][k]]);
-
+      int nOldTrials = junTrials.size();
+      for (int i = 0;i < int(junDips.size()); ++i)
+        for (int j = 0; j < int(junDips[i].size()); ++j)
+          for (int k = j + 1; k < int(junDips[i].size()); ++k)
+            singleJunction(junDips[i][j], junDips[i][k]);
 
       // Loop over different "colours" (now only three different groups).
-      for (int i = 0;i < int(iDips.size()); ++i)
-        for (int j = 0; j < int(iDips[i].size()); ++j) {
-          for (int k = j + 1; k < int(iDips[i].size()); ++k) {
-            for (int l = k + 1; l < int(iDips[i].size()); ++l)
-              singleJunction(dipoles[iDips[i][j]], dipoles[iDips[i][k]],
-                dipoles[iDips[i][l]]);
-          }
-        }
+      for (int i = 0;i < int(junDips.size()); ++i)
+        for (int j = 0; j < int(junDips[i].size()); ++j)
+          tripleJunctions(junDips[i][j], junDips[i], j + 1);
+      mergeTrials(junTrials, nOldTrials);
 
       // Do inner loop for junction reconnections
       for (int iInnerLoop = 0;junTrials.size() > 0; ++iInnerLoop) {
@@ -951,11 +944,11 @@ void ColourReconnection::singleReconnection(ColourDipolePtr& dip1,
   // Calculate the difference in lambda.
   double lambdaDiff = getLambdaDiff(dip1, dip2);
 
-  // Insert into trial reconnection if anything is gained.
+  // Store trial reconnection if anything is gained. The caller is
+  // responsible for merging it into the sorted list.
   if (lambdaDiff > MINIMUMGAIN) {
     TrialReconnection dipTrial(dip1, dip2, 0, 0, 5, lambdaDiff);
-    dipTrials.insert(lower_bound(dipTrials.begin(), dipTrials.end(),
-         dipTrial, cmpTrials), dipTrial);
+    dipTrials.push_back(dipTrial);
   }
 
 }
@@ -1077,8 +1070,7 @@ void ColourReconnection::singleJunction(ColourDipolePtr& dip1,
   double lambdaDiff = getLambdaDiff(dip1, dip2, dip3, dip4, 0);
   if (lambdaDiff > MINIMUMGAINJUN) {
     TrialReconnection junTrial(dip1, dip2, dip3, dip4, 0, lambdaDiff);
-    junTrials.insert(lower_bound(junTrials.begin(), junTrials.end(),
-         junTrial, cmpTrials), junTrial);
+    junTrials.push_back(junTrial);
   }
   // Outer loop
   while (true) {
@@ -1099,8 +1091,7 @@ void ColourReconnection::singleJunction(ColourDipolePtr& dip1,
         if (lambdaDiff > MINIMUMGAINJUN) {
 
           TrialReconnection junTrial(dip1, dip2, dip3, dip4, 1, lambdaDiff);
-          junTrials.insert(lower_bound(junTrials.begin(), junTrials.end(),
-             junTrial, cmpTrials), junTrial);
+          junTrials.push_back(junTrial);
         }
       }
 
@@ -1130,8 +1121,7 @@ void ColourReconnection::singleJunction(ColourDipolePtr& dip1,
         if (lambdaDiff > MINIMUMGAINJUN) {
 
           TrialReconnection junTrial(dip1, dip2, dip3, dip4, 2, lambdaDiff);
-          junTrials.insert(lower_bound(junTrials.begin(), junTrials.end(),
-             junTrial, cmpTrials), junTrial);
+          junTrials.push_back(junTrial);
         }
       }
 
@@ -1202,8 +1192,7 @@ void ColourReconnection::singleJunction(const ColourDipolePtr& dip1,
   const double lambdaDiff = getLambdaDiff(dip1, dip2, dip3, nullptr, 3);
   if (lambdaDiff > MINIMUMGAINJUN) {
     TrialReconnection junTrial(dip1, dip2, dip3, nullptr, 3, lambdaDiff);
-    junTrials.insert(lower_bound(junTrials.begin(), junTrials.end(), junTrial,
-                                 cmpTrials), junTrial);
+    junTrials.push_back(junTrial);
   }
 
   // Done.
@@ -1213,6 +1202,72 @@ void ColourReconnection::singleJunction(const ColourDipolePtr& dip1,
 
 // ------------------------------------------------------------------
 
+// Try all three-dipole junctions with dip1 as first leg. The pairwise
+// requirements of singleJunction are checked once per partner, so that
+// only the triples that can pass them are tried. The order of the
+// remaining calls, and thereby the outcome, is unchanged.
+
+void ColourReconnection::tripleJunctions(const ColourDipolePtr& dip1,
+  const vector<ColourDipolePtr>& dips, int iBeg) {
+
+  if (!isJunctionLeg(dip1)) return;
+
+  // Time dilation modes that require all pairs to be causally connected.
+  bool checkPairs = (timeDilationMode == 1 || timeDilationMode == 2
+    || timeDilationMode == 4);
+
+  // Find the dipoles that could form a junction together with dip1.
+  vector<ColourDipolePtr> partners;
+  for (int i = iBeg; i < int(dips.size()); ++i) {
+    const ColourDipolePtr& dip2 = dips[i];
+    if (dip2->colReconnection == dip1->colReconnection) continue;
+    if (!isJunctionLeg(dip2) || !checkDist(dip1, dip2)) continue;
+    if (checkPairs && !checkTimeDilation(dip1, dip2)) continue;
+    partners.push_back(dip2);
+  }
+
+  // Try all pairs of partners with different colours.
+  for (int j = 0; j < int(partners.size()); ++j)
+    for (int k = j + 1; k < int(partners.size()); ++k)
+      if (partners[j]->colReconnection != partners[k]->colReconnection)
+        singleJunction(dip1, partners[j], partners[k]);
+
+}
+
+// ------------------------------------------------------------------
+
+// Check whether a dipole can be a leg of a three-dipole junction,
+// i.e. that both ends only belong to one dipole and are not diquarks.
+
+bool ColourReconnection::isJunctionLeg(const ColourDipolePtr& dip) const {
+
+  if (int(particles[dip->iCol].dips.size()) != 1
+    || int(particles[dip->iAcol].dips.size()) != 1) return false;
+  if (!allowDiqJunCR && (particles[dip->iCol].isDiquark()
+    || particles[dip->iAcol].isDiquark())) return false;
+  return true;
+
+}
+
+// ------------------------------------------------------------------
+
+// Merge the trials appended from position nOld into the sorted list.
+// Equivalent to inserting them one by one at the lower bound, i.e. a
+// new trial is placed before all earlier ones with the same lambdaDiff.
+
+void ColourReconnection::mergeTrials(vector<TrialReconnection>& trials,
+  int nOld) {
+
+  if (nOld >= int(trials.size())) return;
+  reverse(trials.begin() + nOld, trials.end());
+  stable_sort(trials.begin() + nOld, trials.end(), cmpTrials);
+  rotate(trials.begin(), trials.begin() + nOld, trials.end());
+  inplace_merge(trials.begin(), trials.end() - nOld, trials.end(), cmpTrials);
+
+}
+
+// ------------------------------------------------------------------
+
 // Form pseudoparticle of a given dipole (or junction system).
 
 void ColourReconnection::makePseudoParticle(ColourDipolePtr& dip, int status,
@@ -3000,22 +3055,20 @@ void ColourReconnection::doDipoleTrial(TrialReconnection& trial) {
 
 void ColourReconnection::updateDipoleTrials() {
 
-  // Identify (and then erase) any junTrials that contain a used dipole.
-  vector<int> eraseTrials;
-  // Remove any dipTrials that contains a used dipole.
+  // Remove any dipTrials that contains a used dipole, keeping the order
+  // of the remaining ones.
+  int nKeep = 0;
   for (int i = 0; i < int(dipTrials.size()); ++i) {
-    for (int j = 0;j < 2; ++j) {
-      if (binary_search(usedDipoles.begin(), usedDipoles.end(),
-          dipTrials[i].dips[j]) ) {
-        eraseTrials.push_back(i);
-        break;
-      }
+    bool isUsed = false;
+    for (int j = 0; j < 2 && !isUsed; ++j)
+      isUsed = binary_search(usedDipoles.begin(), usedDipoles.end(),
+        dipTrials[i].dips[j]);
+    if (!isUsed) {
+      if (nKeep != i) dipTrials[nKeep] = dipTrials[i];
+      ++nKeep;
     }
   }
-  // Erase (stepping backwards to preserve indexing).
-  for (int iEra = int(eraseTrials.size()) - 1; iEra >= 0; --iEra) {
-    dipTrials.erase(dipTrials.begin() + eraseTrials[iEra]);
-  }
+  dipTrials.erase(dipTrials.begin() + nKeep, dipTrials.end());
 
   // Make list of active dipoles.
   vector<ColourDipolePtr> activeDipoles;
@@ -3028,6 +3081,7 @@ void ColourReconnection::updateDipoleTrials() {
     if (usedDipoles[i]->isActive)
       for (int j = 0; j < int(activeDipoles.size()); ++j)
         singleReconnection(usedDipoles[i], activeDipoles[j]);
+  mergeTrials(dipTrials, nKeep);
 
 }
 
@@ -3037,21 +3091,20 @@ void ColourReconnection::updateDipoleTrials() {
 
 void ColourReconnection::updateJunctionTrials() {
 
-  // Identify (and then erase) any junTrials that contain a used dipole.
-  vector<int> eraseTrials;
+  // Remove any junTrials that contains a used dipole, keeping the order
+  // of the remaining ones.
+  int nKeep = 0;
   for (int i = 0; i < int(junTrials.size()); ++i) {
-    for (int j = 0; j < 4; ++j) {
-      if (binary_search(usedDipoles.begin(), usedDipoles.end(),
-          junTrials[i].dips[j]) ) {
-        eraseTrials.push_back(i);
-        break;
-      }
+    bool isUsed = false;
+    for (int j = 0; j < 4 && !isUsed; ++j)
+      isUsed = binary_search(usedDipoles.begin(), usedDipoles.end(),
+        junTrials[i].dips[j]);
+    if (!isUsed) {
+      if (nKeep != i) junTrials[nKeep] = junTrials[i];
+      ++nKeep;
     }
   }
-  // Erase (stepping backwards to preserve indexing).
-  for (int iEra = int(eraseTrials.size()) - 1; iEra >= 0; --iEra) {
-    junTrials.erase(junTrials.begin() + eraseTrials[iEra]);
-  }
+  junTrials.erase(junTrials.begin() + nKeep, junTrials.end());
 
   // Make list of active dipoles.
   vector<vector<ColourDipolePtr>> activeDipoles(3, vector<ColourDipolePtr>());
@@ -3073,16 +3126,10 @@ void ColourReconnection::updateJunctionTrials() {
   for (int i = 0;i < int(usedDipoles.size()); ++i) {
     if (!usedDipoles[i]->isActive) { continue; }
     if (usedDipoles[i]->isJun || usedDipoles[i]->isAntiJun) { continue; }
-    for (int j = 0; j < int(activeDipoles[usedDipoles[i]->
-          colReconnection%3].size()); ++j) {
-      for (int k = j + 1; k < int(activeDipoles[usedDipoles[i]->
-            colReconnection%3].size()); ++k) {
-        singleJunction(usedDipoles[i], activeDipoles[usedDipoles[i]->
-            colReconnection%3][j],
-          activeDipoles[usedDipoles[i]->colReconnection%3][k]);
-      }
-    }
+    tripleJunctions(usedDipoles[i],
+      activeDipoles[usedDipoles[i]->colReconnection%3]);
   }
+  mergeTrials(junTrials, nKeep);
 
 }
 
@@ -22,6 +22,17 @@ namespace Pythia8 {
 // Number of times to try a decay sampling.
 const int DeuteronProduction::NTRYDECAY = 10;
 
+// Number of linear bins in k below kMax, and of logarithmic bins from kMax
+// up to KLOGMAX times kMax, for the binned cross-section maxima. Number of
+// samples per bin used to find each maximum.
+const int    DeuteronProduction::NKBINS    = 200;
+const int    DeuteronProduction::NKLOGBINS = 100;
+const int    DeuteronProduction::NKSUB     = 4;
+const double DeuteronProduction::KLOGMAX   = 1000.;
+
+// Safety margin for the binned maxima, for maxima missed by the search.
+const double DeuteronProduction::SIGMAMARGIN = 1.2;
+
   // These numbers are hardwired empirical parameters,
 // intended to speed up the M-generator.
 const double DeuteronProduction::WTCORRECTION[11] = { 1., 1., 1.,
@@ -50,6 +61,9 @@ bool DeuteronProduction::init() {
   kMax    = parm("DeuteronProduction:kMax");
   kTol    = parm("DeuteronProduction:kTol");
   kSteps  = mode("DeuteronProduction:kSteps");
+  binnedMaxima = flag("DeuteronProduction:binnedMaxima");
+  dkBin    = kMax/NKBINS;
+  dlogkBin = log(KLOGMAX)/NKLOGBINS;
 
   // Check the configuration vectors.
   if (parms.size() != ids.size() || parms.size() != models.size()) {
@@ -113,8 +127,24 @@ bool DeuteronProduction::init() {
       mass[id] = particleDataPtr->m0(ids[chn][id]);
     masses.push_back(mass);
 
-    // Calculate the maximum cross-section.
-    maximum(k, s, chn);
+    // Calculate the maximum cross-section and the binned maxima. These
+    // only depend on the model, parameters, masses and technical settings,
+    // so are reused when unchanged since the previous initialization.
+    vector<double> key(1, models[chn]);
+    double techs[] = {mPion, kMin, kMax, kTol, double(kSteps)};
+    key.insert(key.end(), techs, techs + 5);
+    key.insert(key.end(), mass.begin(), mass.end());
+    key.insert(key.end(), parms[chn].begin(), parms[chn].end());
+    if (chn >= int(cacheKeys.size())) {
+      cacheKeys.resize(chn + 1); cacheK.resize(chn + 1);
+      cacheS.resize(chn + 1); sigmaBins.resize(chn + 1);
+    }
+    if (key != cacheKeys[chn]) {
+      maximum(cacheK[chn], cacheS[chn], chn);
+      binMaxima(chn);
+      cacheKeys[chn] = key;
+    }
+    k = cacheK[chn]; s = cacheS[chn];
     if (verbose) {
       string proc(" |");
       for (int id = 0; id < 2; ++id)
@@ -128,6 +158,8 @@ bool DeuteronProduction::init() {
     }
     if (s > max) max = s;
   }
+  cacheKeys.resize(ids.size()); cacheK.resize(ids.size());
+  cacheS.resize(ids.size()); sigmaBins.resize(ids.size());
 
   // Set normalization.
   norm = parm("DeuteronProduction:norm");
@@ -189,21 +221,43 @@ void DeuteronProduction::bind(Event& event, vector<int>& prts) {
     Particle &prt1 = event[cmbs[cmb].second];
     if (prt0.status() < 0 || prt1.status() < 0) continue;
 
-    // Calculate the momentum difference.
+    // Find the k bin, if any, with cross-section maxima for the pair,
+    // using the momentum difference calculated from invariants.
     Vec4 p0(prt0.p()), p1(prt1.p()), p(p0 + p1);
-    p0.bstback(p);
-    p1.bstback(p);
-    double k((p0 - p1).pAbs());
+    double k(0);
+    int bin(-1);
+    if (binnedMaxima) {
+      double m2(p.m2Calc()), m02(p0.m2Calc()), m12(p1.m2Calc());
+      k = sqrtpos((pow2(m2 - m02 - m12) - 4*m02*m12)/m2);
+      if (k < kMax) bin = int(k/dkBin);
+      else if (k < kMax*KLOGMAX)
+        bin = min(NKBINS + int(log(k/kMax)/dlogkBin), NKBINS + NKLOGBINS - 1);
+    }
+    bool boosted(false);
 
-    // Try binding each channel.
+    // Try binding each channel. The cross-section is only evaluated when
+    // the random number is below the maximum of the k bin.
     double sum(0);
     for (int chn = 0; chn < int(ids.size()); ++chn) {
-      if (prt0.idAbs() == ids[chn][0] && prt1.idAbs() == ids[chn][1])
-        sigmas[chn] = sigma(k, chn);
-      else {sigmas[chn] = 0; continue;}
+      sigmas[chn] = 0;
+      if (prt0.idAbs() != ids[chn][0] || prt1.idAbs() != ids[chn][1])
+        continue;
+      double rndm(rndmPtr->flat());
+      if (bin >= 0 && rndm >= sigmaBins[chn][bin]/norm) continue;
+
+      // Calculate the momentum difference in the pair rest frame.
+      if (!boosted) {
+        p0.bstback(p);
+        p1.bstback(p);
+        k = (p0 - p1).pAbs();
+        boosted = true;
+      }
+      sigmas[chn] = sigma(k, chn);
       if (sigmas[chn] > norm)
         loggerPtr->WARNING_MSG("maximum weight exceeded");
-      if (rndmPtr->flat() >= sigmas[chn]/norm) sigmas[chn] = 0;
+      else if (bin >= 0 && sigmas[chn] > sigmaBins[chn][bin])
+        loggerPtr->WARNING_MSG("maximum weight in k bin exceeded");
+      if (rndm >= sigmas[chn]/norm) sigmas[chn] = 0;
       sum += sigmas[chn];
     }
 
@@ -440,6 +494,49 @@ void DeuteronProduction::maximum(double& k, double& s, int chn) {
 
 //--------------------------------------------------------------------------
 
+// Find the cross-section maximum in each bin of k. The bin is sampled at
+// a few points, and the largest sample is refined by a bracketed search
+// between its neighbours, as in maximum(), before the safety margin is
+// added. Bins where the cross-section is not finite are given an infinite
+// maximum, so that the cross-section is always used.
+
+void DeuteronProduction::binMaxima(int chn) {
+
+  vector<double>& bins = sigmaBins[chn];
+  bins.assign(NKBINS + NKLOGBINS, 0);
+  vector<double> xs(NKSUB + 1), ys(NKSUB + 1);
+  for (int bin = 0; bin < NKBINS + NKLOGBINS; ++bin) {
+
+    // Sample the bin, including its edges.
+    int im(0);
+    for (int i = 0; i <= NKSUB; ++i) {
+      double x(bin + double(i)/NKSUB);
+      xs[i] = bin < NKBINS ? dkBin*x : kMax*exp(dlogkBin*(x - NKBINS));
+      ys[i] = sigma(xs[i], chn);
+      if (!isfinite(ys[i])) ys[i] = numeric_limits<double>::infinity();
+      if (ys[i] > ys[im]) im = i;
+    }
+
+    // Halve the bracket around the largest value until the tolerance.
+    double ym(ys[im]), xm(xs[im]);
+    double xa(xs[max(im - 1, 0)]), xb(xs[min(im + 1, NKSUB)]);
+    for (int itr = 0; itr < 1000 && isfinite(ym) && xb - xa > kTol*xb;
+      ++itr) {
+      double xl((xa + xm)/2), xr((xm + xb)/2);
+      double yl(sigma(xl, chn)), yr(sigma(xr, chn));
+      if (!isfinite(yl) || !isfinite(yr))
+        ym = numeric_limits<double>::infinity();
+      else if (yl > ym && yl >= yr) {xb = xm; xm = xl; ym = yl;}
+      else if (yr > ym) {xa = xm; xm = xr; ym = yr;}
+      else {xa = xl; xb = xr;}
+    }
+    bins[bin] = ym*SIGMAMARGIN;
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Parse the IDs.
 
 vector<int> DeuteronProduction::parseIds(string line) {
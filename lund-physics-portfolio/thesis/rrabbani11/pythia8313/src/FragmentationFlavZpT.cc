@@ -754,6 +754,40 @@ void StringFlav::init(double kappaModifier, double strangeJunc,
 
 //--------------------------------------------------------------------------
 
+// Change the string-break parameters directly, e.g. for rope hadronization.
+// Equivalent to init() with the same values stored in Settings, but
+// only the affected quantities are recalculated.
+
+void StringFlav::setFragPars(const FragParContainer& fragPars) {
+
+  // Basic parameters for generation of new flavour.
+  probQQtoQ       = fragPars.probQQtoQ;
+  probStoUD       = fragPars.probStoUD;
+  probSQtoQQ      = fragPars.probSQtoQQ;
+  probQQ1toQQ0    = fragPars.probQQ1toQQ0;
+  sigmaHad        = (sqrt(2.0)*fragPars.sigma);
+
+  // Save "vacuum" parameters for closepacking init() function.
+  probStoUDSav    = probStoUD;
+  probQQtoQSav    = probQQtoQ;
+  probSQtoQQSav   = probSQtoQQ;
+  probQQ1toQQ0Sav = probQQ1toQQ0;
+  alphaQQSav      = (1. + 2. * probSQtoQQ * probStoUD + 9. * probQQ1toQQ0
+    + 6. * probSQtoQQ * probQQ1toQQ0 * probStoUD
+    + 3. * probQQ1toQQ0 * pow2(probSQtoQQ * probStoUD)) / (2. + probStoUD);
+
+  // Calculate derived parameters.
+  initDerived();
+
+  // Initialize winning parameters.
+  hadronIDwin   = 0;
+  idNewWin      = 0;
+  hadronMassWin = -1.0;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Pick a new flavour (including diquarks) given an incoming one for
 // Gaussian pTq^2 distribution.
 
@@ -70,6 +70,40 @@ bool DecayChannel::contains(int id1, int id2, int id3) const {
 
 }
 
+//--------------------------------------------------------------------------
+
+// Write the channel in binary format, for ParticleData::writeSnapshot.
+
+void DecayChannel::writeSnapshot(ostream& os) const {
+
+  writeBinary(os, onModeSave);
+  writeBinary(os, bRatioSave);
+  writeBinary(os, currentBRSave);
+  writeBinary(os, onShellWidthSave);
+  writeBinary(os, openSecPos);
+  writeBinary(os, openSecNeg);
+  writeBinary(os, meModeSave);
+  writeBinary(os, nProd);
+  for (int j = 0; j < 8; ++j) writeBinary(os, prod[j]);
+  writeBinary(os, hasChangedSave);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read back a channel written by writeSnapshot.
+
+bool DecayChannel::readSnapshot(istream& is) {
+
+  bool isOK = readBinary(is, onModeSave) && readBinary(is, bRatioSave)
+    && readBinary(is, currentBRSave) && readBinary(is, onShellWidthSave)
+    && readBinary(is, openSecPos) && readBinary(is, openSecNeg)
+    && readBinary(is, meModeSave) && readBinary(is, nProd);
+  for (int j = 0; j < 8; ++j) isOK = isOK && readBinary(is, prod[j]);
+  return isOK && readBinary(is, hasChangedSave);
+
+}
+
 //==========================================================================
 
 // ParticleDataEntry class.
@@ -615,6 +649,85 @@ void ParticleDataEntry::setConstituentMass() {
 
 }
 
+//--------------------------------------------------------------------------
+
+// Write the entry in binary format, for ParticleData::writeSnapshot.
+
+void ParticleDataEntry::writeSnapshot(ostream& os) const {
+
+  // Particle properties, including the derived Breit-Wigner ones.
+  writeBinary(os, idSave);
+  writeBinary(os, nameSave);
+  writeBinary(os, antiNameSave);
+  writeBinary(os, spinTypeSave);
+  writeBinary(os, chargeTypeSave);
+  writeBinary(os, colTypeSave);
+  writeBinary(os, m0Save);
+  writeBinary(os, mWidthSave);
+  writeBinary(os, mMinSave);
+  writeBinary(os, mMaxSave);
+  writeBinary(os, tau0Save);
+  writeBinary(os, constituentMassSave);
+  writeBinary(os, hasAntiSave);
+  writeBinary(os, isResonanceSave);
+  writeBinary(os, mayDecaySave);
+  writeBinary(os, tauCalcSave);
+  writeBinary(os, varWidthSave);
+  writeBinary(os, doExternalDecaySave);
+  writeBinary(os, isVisibleSave);
+  writeBinary(os, doForceWidthSave);
+  writeBinary(os, hasChangedSave);
+  writeBinary(os, hasChangedMMinSave);
+  writeBinary(os, hasChangedMMaxSave);
+  writeBinary(os, modeBWnow);
+  writeBinary(os, modeTau0now);
+  writeBinary(os, atanLow);
+  writeBinary(os, atanDif);
+  writeBinary(os, mThr);
+  writeBinary(os, currentBRSum);
+
+  // Decay channels.
+  writeBinary(os, channels.size());
+  for (const DecayChannel& channel : channels) channel.writeSnapshot(os);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read back an entry written by writeSnapshot.
+
+bool ParticleDataEntry::readSnapshot(istream& is) {
+
+  // Particle properties, including the derived Breit-Wigner ones.
+  if ( !( readBinary(is, idSave) && readBinary(is, nameSave)
+    && readBinary(is, antiNameSave) && readBinary(is, spinTypeSave)
+    && readBinary(is, chargeTypeSave) && readBinary(is, colTypeSave)
+    && readBinary(is, m0Save) && readBinary(is, mWidthSave)
+    && readBinary(is, mMinSave) && readBinary(is, mMaxSave)
+    && readBinary(is, tau0Save) && readBinary(is, constituentMassSave)
+    && readBinary(is, hasAntiSave) && readBinary(is, isResonanceSave)
+    && readBinary(is, mayDecaySave) && readBinary(is, tauCalcSave)
+    && readBinary(is, varWidthSave) && readBinary(is, doExternalDecaySave)
+    && readBinary(is, isVisibleSave) && readBinary(is, doForceWidthSave)
+    && readBinary(is, hasChangedSave) && readBinary(is, hasChangedMMinSave)
+    && readBinary(is, hasChangedMMaxSave) && readBinary(is, modeBWnow)
+    && readBinary(is, modeTau0now) && readBinary(is, atanLow)
+    && readBinary(is, atanDif) && readBinary(is, mThr)
+    && readBinary(is, currentBRSum) ) ) return false;
+
+  // Decay channels.
+  size_t nChannels = 0;
+  if (!readBinary(is, nChannels)) return false;
+  channels.resize(0);
+  for (size_t i = 0; i < nChannels; ++i) {
+    DecayChannel channel;
+    if (!channel.readSnapshot(is)) return false;
+    channels.push_back(channel);
+  }
+  return true;
+
+}
+
 //==========================================================================
 
 // ParticleData class.
@@ -623,6 +736,14 @@ void ParticleDataEntry::setConstituentMass() {
 
 //--------------------------------------------------------------------------
 
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Smallest size of the hash index; must be a power of two.
+const int ParticleData::NHASHMIN = 16;
+
+//--------------------------------------------------------------------------
+
 // Get data to be distributed among particles during setup.
 // Note: this routine is called twice. Firstly from init(...), but
 // the data should not be used at that point, so is likely overkill.
@@ -918,6 +1039,7 @@ bool ParticleData::copyXML(const ParticleData &particleDataIn) {
 
   // First Reset everything.
   pdt.clear();
+  rebuildIndex();
   xmlFileSav.clear();
   readStringHistory.resize(0);
   readStringSubrun.clear();
@@ -939,6 +1061,7 @@ bool ParticleData::loadXML(istream& is, bool reset) {
   // Normally reset whole database before beginning.
   if (reset) {
     pdt.clear();
+    rebuildIndex();
     xmlFileSav.clear();
     readStringHistory.resize(0);
     readStringSubrun.clear();
@@ -1036,7 +1159,7 @@ bool ParticleData::processXML(bool reset) {
       bool varWidthTmp   = boolAttributeValue( line, "varWidth");
 
       // Erase if particle already exists.
-      if (isParticle(idTmp)) pdt.erase(idTmp);
+      if (isParticle(idTmp)) {pdt.erase(idTmp); rebuildIndex();}
 
       // Store new particle. Save pointer, to be used for decay channels.
       addParticle( idTmp, nameTmp, antiNameTmp, spinTypeTmp, chargeTypeTmp,
@@ -1167,6 +1290,7 @@ bool ParticleData::readFF(istream& is, bool reset) {
   // Normally reset whole database before beginning.
   if (reset) {
     pdt.clear();
+    rebuildIndex();
     readStringHistory.resize(0);
     readStringSubrun.clear();
     isInit = false;
@@ -1215,7 +1339,7 @@ bool ParticleData::readFF(istream& is, bool reset) {
       }
 
       // Erase if particle already exists.
-      if (isParticle(idTmp)) pdt.erase(idTmp);
+      if (isParticle(idTmp)) {pdt.erase(idTmp); rebuildIndex();}
 
       // Store new particle. Save pointer, to be used for decay channels.
       addParticle( idTmp, nameTmp, antiNameTmp, spinTypeTmp, chargeTypeTmp,
@@ -1277,6 +1401,63 @@ bool ParticleData::readFF(string inFile, bool reset) {
 
 //--------------------------------------------------------------------------
 
+// Write the complete database in a compact binary format, to be read
+// back by readSnapshot. The common data is not included, but is
+// extracted from the settings database anew when the snapshot is read.
+
+bool ParticleData::writeSnapshot(ostream& os) {
+
+  writeBinary(os, pdt.size());
+  for (const auto& entry : pdt) {
+    writeBinary(os, entry.first);
+    entry.second->writeSnapshot(os);
+  }
+  writeBinary(os, readStringHistory);
+  writeBinary(os, readStringSubrun);
+  writeBinary(os, readingFailedSave);
+  return os.good();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Replace the database by one written with writeSnapshot. The XML lines
+// are not stored, so copyXML cannot be used with the result.
+
+bool ParticleData::readSnapshot(istream& is) {
+
+  // Common data and reset of the current content.
+  initCommon();
+  pdt.clear();
+  xmlFileSav.clear();
+  particlePtr = nullptr;
+
+  // Read in all the entries and point them back to this database.
+  size_t nEntries = 0;
+  isInit = readBinary(is, nEntries);
+  for (size_t i = 0; isInit && i < nEntries; ++i) {
+    int idNow = 0;
+    ParticleDataEntryPtr entryPtr = make_shared<ParticleDataEntry>();
+    isInit = readBinary(is, idNow) && entryPtr->readSnapshot(is);
+    entryPtr->initPtr(this);
+    pdt[idNow] = entryPtr;
+  }
+  rebuildIndex();
+  isInit = isInit && readBinary(is, readStringHistory)
+    && readBinary(is, readStringSubrun) && readBinary(is, readingFailedSave);
+
+  // Do not leave a partial database behind.
+  if (!isInit) {
+    pdt.clear();
+    rebuildIndex();
+    loggerPtr->ERROR_MSG("could not read particle data snapshot");
+  }
+  return isInit;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Print out complete database in numerical order as a free format file.
 
 void ParticleData::listFF(string outFile) {
@@ -1517,7 +1698,7 @@ void ParticleData::listFF(string outFile) {
 
     // Else start over completely from scratch.
     } else {
-      if (isParticle(idTmp)) pdt.erase(idTmp);
+      if (isParticle(idTmp)) {pdt.erase(idTmp); rebuildIndex();}
       addParticle( idTmp, nameTmp, antiNameTmp, spinTypeTmp, chargeTypeTmp,
         colTypeTmp, m0Tmp, mWidthTmp, mMinTmp, mMaxTmp, tau0Tmp, varWidthTmp);
     }
@@ -2244,6 +2425,52 @@ int ParticleData::nextId(int idIn) const {
 
 //--------------------------------------------------------------------------
 
+// Rebuild the hash index from scratch, with at most half the slots filled.
+
+void ParticleData::rebuildIndex() {
+
+  // Find table size, as a power of two, and the matching hash shift.
+  int nSlots = NHASHMIN;
+  hashShift  = 32;
+  for (int n = 1; n < NHASHMIN; n *= 2) --hashShift;
+  while (nSlots < 2 * int(pdt.size()) + 2) {nSlots *= 2; --hashShift;}
+  hashMask   = nSlots - 1;
+
+  // Empty the table and fill it with all (non-empty) map entries.
+  hashIds.assign(nSlots, -1);
+  hashPtrs.assign(nSlots, nullptr);
+  nHashed = 0;
+  for (auto pdtEntry = pdt.begin(); pdtEntry != pdt.end(); ++pdtEntry)
+    if (pdtEntry->second != nullptr) addToIndex(pdtEntry->first);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Add a map entry to the hash index, or update the pointer if it is
+// already there. Rebuild with a larger table when it gets half filled.
+
+void ParticleData::addToIndex(int idAbs) {
+
+  // Entry to store, if any.
+  auto pdtEntry = pdt.find(idAbs);
+  if (pdtEntry == pdt.end() || pdtEntry->second == nullptr) return;
+
+  // Probe for the id or the first empty slot.
+  unsigned int iHash = hashStart(idAbs);
+  while (hashIds[iHash] != -1 && hashIds[iHash] != idAbs)
+    iHash = (iHash + 1) & hashMask;
+  if (hashIds[iHash] == -1) {
+    if (2 * (nHashed + 1) > int(hashIds.size())) {rebuildIndex(); return;}
+    hashIds[iHash] = idAbs;
+    ++nHashed;
+  }
+  hashPtrs[iHash] = pdtEntry->second;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Fractional width associated with open channels of one or two resonances.
 
 double ParticleData::resOpenFrac(int id1In, int id2In, int id3In) {
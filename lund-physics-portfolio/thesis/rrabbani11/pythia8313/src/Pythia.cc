@@ -26,6 +26,9 @@ namespace Pythia8 {
 const double Pythia::VERSIONNUMBERHEAD = PYTHIA_VERSION;
 const double Pythia::VERSIONNUMBERCODE = 8.313;
 
+// Tag at the start of a binary snapshot of the databases.
+const string Pythia::SNAPSHOTTAG = "PYTHIA8SNAPSHOT";
+
 //--------------------------------------------------------------------------
 
 // Constructor.
@@ -172,6 +175,62 @@ Pythia::Pythia( istream& settingsStrings, istream& particleDataStrings,
 
 //--------------------------------------------------------------------------
 
+// Constructor from a binary snapshot of the databases.
+
+Pythia::Pythia( istream& snapshot, bool printBanner) {
+
+  // Initialise / reset pointers and global variables.
+  initPtrs();
+
+  // Check that the stream starts with a snapshot tag.
+  string tag(SNAPSHOTTAG.size(), ' ');
+  snapshot.read( &tag[0], tag.size());
+  isConstructed = snapshot.good() && tag == SNAPSHOTTAG;
+  if (!isConstructed) {
+    logger.ABORT_MSG("input is not a settings and particle data snapshot");
+    return;
+  }
+
+  // Read in the settings database.
+  settings.initPtrs(&logger, &particleData, &particleDataBuffer);
+  isConstructed = settings.readSnapshot( snapshot);
+  if (!isConstructed) {
+    logger.ABORT_MSG("settings unavailable");
+    return;
+  }
+
+  // The environment variable takes precedence over the stored XML path,
+  // since the snapshot may have been written on another installation.
+  const char* envPath = getenv("PYTHIA8DATA");
+  xmlPath = settings.word("xmlPath");
+  if (envPath && string(envPath) != "") {
+    xmlPath = envPath;
+    if (xmlPath[xmlPath.length() - 1] != '/') xmlPath += "/";
+    settings.word("xmlPath", xmlPath);
+  }
+
+  // Check XML and header version numbers match code version number.
+  if (!checkVersion()) return;
+
+  // Read in the particle database.
+  particleData.initPtrs( &infoPrivate);
+  isConstructed = particleData.readSnapshot( snapshot);
+  if (!isConstructed) {
+    logger.ABORT_MSG("particle data unavailable");
+    return;
+  }
+
+  // Write the Pythia banner to output.
+  if (printBanner) banner();
+
+  // Not initialized until at the end of the init() call.
+  isInit = false;
+  infoPrivate.addCounter(0);
+
+}
+
+//--------------------------------------------------------------------------
+
 // Initialise new Pythia object (common code called by constructors).
 
 void Pythia::initPtrs() {
@@ -397,6 +456,40 @@ bool Pythia::checkVersion() {
 
 //--------------------------------------------------------------------------
 
+// Write a binary snapshot of the settings and particle databases to file,
+// to be used by the snapshot constructor.
+
+bool Pythia::writeSnapshot(string fileName) {
+
+  ofstream ofs(fileName.c_str(), ios::binary);
+  if (!ofs.good()) {
+    logger.ERROR_MSG("could not open file", fileName);
+    return false;
+  }
+  return writeSnapshot(ofs);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write a binary snapshot of the settings and particle databases to stream.
+
+bool Pythia::writeSnapshot(ostream& os) {
+
+  // Check that constructor worked.
+  if (!isConstructed) {
+    logger.ERROR_MSG("constructor initialization failed");
+    return false;
+  }
+
+  // Tag, followed by the two databases.
+  os.write( SNAPSHOTTAG.data(), SNAPSHOTTAG.size());
+  return settings.writeSnapshot(os) && particleData.writeSnapshot(os);
+
+}
+
+//--------------------------------------------------------------------------
+
 // Routine to initialize with the variable values of the Beams kind.
 
 bool Pythia::init() {
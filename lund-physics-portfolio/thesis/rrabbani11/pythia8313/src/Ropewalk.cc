@@ -496,6 +496,18 @@ RopeDipole* dip2;
 
 //--------------------------------------------------------------------------
 
+// Constants: could be changed here if desired, but normally should not.
+
+// Maximal number of cells along each side of the grid used to find
+// overlapping dipoles.
+const double Ropewalk::OVERLAPNCELLMAX = 1000.;
+
+// Width of the cells used to find shoving excitations, in units of the
+// cut-off radius, with a margin for rounding.
+const double Ropewalk::SHOVECELLWIDTH = 1.01;
+
+//--------------------------------------------------------------------------
+
 // The Ropewalk init function sets parameters and pointers.
 
 bool Ropewalk::init() {
@@ -520,6 +532,8 @@ bool Ropewalk::init() {
   tInit                = parm("Ropewalk:tInit");
   showerCut            = parm("TimeShower:pTmin");
   alwaysHighest        = flag("Ropewalk:alwaysHighest");
+  indexOverlaps        = flag("Ropewalk:indexOverlaps");
+  indexShoving         = flag("Ropewalk:indexShoving");
 
   // Creat the interface objects.
   if ( flag("Ropewalk:doShoving") ) {
@@ -620,11 +634,69 @@ double Ropewalk::getKappaHere(int e1, int e2, double yfrac) {
 
 bool Ropewalk::calculateOverlaps() {
 
+  // The dipoles that are large enough to take part.
+  vector<RopeDipole*> dips;
+  for (DMap::iterator itr = dipoles.begin(); itr != dipoles.end(); ++itr)
+    if (itr->second.dipoleMomentum().m2Calc() >= pow2(m0))
+      dips.push_back( &(itr->second) );
+  int nDip = dips.size();
+
+  // Transverse positions of the dipole ends in the lab frame. The index
+  // is only valid if all vertices have the same t and z, else the
+  // transverse distance in a dipole rest frame is not bounded by the
+  // lab transverse distance.
+  bool useIndex = indexOverlaps && nDip > 1;
+  vector<double> x1(nDip), y1(nDip), x2(nDip), y2(nDip);
+  Vec4 vRef = (nDip > 0) ? dips[0]->d1Ptr()->getParticlePtr()->vProd()
+    : Vec4();
+  for (int i = 0; i < nDip && useIndex; ++i) {
+    Vec4 v1 = dips[i]->d1Ptr()->getParticlePtr()->vProd();
+    Vec4 v2 = dips[i]->d2Ptr()->getParticlePtr()->vProd();
+    if (v1.e() != vRef.e() || v1.pz() != vRef.pz() || v2.e() != vRef.e()
+      || v2.pz() != vRef.pz()) useIndex = false;
+    x1[i] = v1.px() * MM2FM;
+    y1[i] = v1.py() * MM2FM;
+    x2[i] = v2.px() * MM2FM;
+    y2[i] = v2.py() * MM2FM;
+  }
+
+  // Sort the dipoles into a grid of cells in the transverse plane,
+  // each by the bounding box of its end points.
+  double xLow = 0., yLow = 0., cellSize = 1., reachMax = 0.;
+  int nxCell = 1, nyCell = 1;
+  vector< vector<int> > cells;
+  if (useIndex) {
+    xLow = min(x1[0], x2[0]);
+    yLow = min(y1[0], y2[0]);
+    double xHigh = max(x1[0], x2[0]);
+    double yHigh = max(y1[0], y2[0]);
+    for (int i = 1; i < nDip; ++i) {
+      xLow  = min( xLow,  min(x1[i], x2[i]) );
+      yLow  = min( yLow,  min(y1[i], y2[i]) );
+      xHigh = max( xHigh, max(x1[i], x2[i]) );
+      yHigh = max( yHigh, max(y1[i], y2[i]) );
+    }
+    cellSize = max( max(2. * r0, 1e-6),
+      max(xHigh - xLow, yHigh - yLow) / OVERLAPNCELLMAX );
+    reachMax = (xHigh - xLow) + (yHigh - yLow) + cellSize;
+    nxCell = int((xHigh - xLow) / cellSize) + 1;
+    nyCell = int((yHigh - yLow) / cellSize) + 1;
+    cells.resize(nxCell * nyCell);
+    for (int i = 0; i < nDip; ++i) {
+      int ix1 = int((min(x1[i], x2[i]) - xLow) / cellSize);
+      int ix2 = min( nxCell - 1, int((max(x1[i], x2[i]) - xLow) / cellSize));
+      int iy1 = int((min(y1[i], y2[i]) - yLow) / cellSize);
+      int iy2 = min( nyCell - 1, int((max(y1[i], y2[i]) - yLow) / cellSize));
+      for (int ix = ix1; ix <= ix2; ++ix)
+      for (int iy = iy1; iy <= iy2; ++iy)
+        cells[ix * nyCell + iy].push_back(i);
+    }
+  }
+  vector<int> candidates, lastSeen(nDip, -1);
+
   // Go through all dipoles.
-  for (multimap< pair<int,int>, RopeDipole>::iterator itr = dipoles.begin();
-    itr != dipoles.end(); ++itr ) {
-    RopeDipole* d1 = &(itr->second);
-    if (d1->dipoleMomentum().m2Calc() < pow2(m0)) continue;
+  for (int i1 = 0; i1 < nDip; ++i1) {
+    RopeDipole* d1 = dips[i1];
 
     // RopeDipoles rapidities in dipole rest frame.
     RotBstMatrix dipoleRestFrame = d1->getDipoleRestFrame();
@@ -632,14 +704,62 @@ bool Ropewalk::calculateOverlaps() {
     double ya1 = d1->d2Ptr()->rap(m0, dipoleRestFrame);
     if (yc1 <= ya1) continue;
 
-    // Go through all possible overlapping dipoles.
-    for (multimap< pair<int,int>, RopeDipole>::iterator itr2 = dipoles.begin();
-      itr2 != dipoles.end(); ++itr2) {
-      RopeDipole* d2 = &(itr2->second);
+    // By default go through all possible overlapping dipoles.
+    bool allCandidates = true;
+
+    // With the index only dipoles that can come within 2 r0 of this one.
+    // The rest-frame transverse distance is a linear map M of the lab
+    // transverse distance, and at least the smallest singular value of
+    // M times it. Along its own axis the point on this dipole is at most
+    // one dipole length outside the dipole, since yc1 > 0 > ya1.
+    if (useIndex && yc1 > 0. && ya1 < 0.) {
+      Vec4 ex(1., 0., 0., 0.), ey(0., 1., 0., 0.);
+      ex.rotbst(dipoleRestFrame);
+      ey.rotbst(dipoleRestFrame);
+      double mxx = pow2(ex.px()) + pow2(ex.py());
+      double myy = pow2(ey.px()) + pow2(ey.py());
+      double mxy = ex.px() * ey.px() + ex.py() * ey.py();
+      double sig2Min = 0.5 * (mxx + myy)
+        - sqrt( 0.25 * pow2(mxx - myy) + pow2(mxy) );
+      double rReach = (sig2Min > 0.)
+        ? 2. * r0 / sqrt(sig2Min) * (1. + 1e-6) + 1e-6 : reachMax;
+      if (rReach < reachMax) {
+        double xA = 2. * x1[i1] - x2[i1];
+        double yA = 2. * y1[i1] - y2[i1];
+        int ix1 = max( 0, int((min(xA, x2[i1]) - rReach - xLow) / cellSize));
+        int ix2 = min( nxCell - 1,
+          int((max(xA, x2[i1]) + rReach - xLow) / cellSize));
+        int iy1 = max( 0, int((min(yA, y2[i1]) - rReach - yLow) / cellSize));
+        int iy2 = min( nyCell - 1,
+          int((max(yA, y2[i1]) + rReach - yLow) / cellSize));
+        if ( (ix2 - ix1 + 1) * (iy2 - iy1 + 1) < nDip) {
+          allCandidates = false;
+          candidates.clear();
+          for (int ix = ix1; ix <= ix2; ++ix)
+          for (int iy = iy1; iy <= iy2; ++iy) {
+            vector<int>& cell = cells[ix * nyCell + iy];
+            for (int j = 0; j < int(cell.size()); ++j)
+            if (lastSeen[cell[j]] != i1) {
+              lastSeen[cell[j]] = i1;
+              candidates.push_back(cell[j]);
+            }
+          }
+          // Keep the same order as when going through all dipoles.
+          sort( candidates.begin(), candidates.end());
+        }
+      }
+    }
+    if (allCandidates) {
+      candidates.resize(nDip);
+      for (int i2 = 0; i2 < nDip; ++i2) candidates[i2] = i2;
+    }
 
-      // Skip self and overlaps with miniscule dipoles.
+    // Go through the candidate overlapping dipoles.
+    for (int j = 0; j < int(candidates.size()); ++j) {
+      RopeDipole* d2 = dips[candidates[j]];
+
+      // Skip self.
       if (d1 == d2) continue;
-      if (d2->dipoleMomentum().m2Calc() < pow2(m0)) continue;
 
       // Ignore if not overlapping in rapidity.
       OverlappingRopeDipole od(d2, m0, dipoleRestFrame);
@@ -735,6 +855,7 @@ void Ropewalk::shoveTheDipoles(Event& event) {
   map<double, vector<Exc> > exPairs;
   for (int i = 0, N = eParticles.size(); i < N; ++i) eParticles[i].clear();
   eParticles.clear();
+  vector< vector<RopeDipole*> > sliceDipoles;
   for (int i = 0, N = rapidities.size(); i < N; ++i) {
   // Construct an empty vector of excitation particles.
   eParticles.push_back( vector<Particle>() );
@@ -772,6 +893,9 @@ void Ropewalk::shoveTheDipoles(Event& event) {
       pp.vProd( tmp[j]->bInterpolateLab(ySample,m0) * FM2MM);
       eParticles[i].push_back(pp);
     }
+  sliceDipoles.push_back(tmp);
+  if (indexShoving) continue;
+
   // Construct all pairs of possible excitations in this slice.
   exPairs[ySample] = vector<Exc>();
   for (int j = 0, M = tmp.size(); j < M; ++j)
@@ -783,6 +907,9 @@ void Ropewalk::shoveTheDipoles(Event& event) {
     }
   }
 
+  // Shove only excitations close to each other.
+  if (indexShoving) shoveIndexed(rapidities, sliceDipoles);
+
   // Give the excitations pointers to the excitation particles.
   for (map<double, vector<Exc> >::iterator slItr = exPairs.begin();
     slItr != exPairs.end(); ++slItr) {
@@ -792,7 +919,8 @@ void Ropewalk::shoveTheDipoles(Event& event) {
     }
   }
 
-  // Shoving loop.
+  // Shoving loop, going through all pairs.
+  if (!indexShoving)
   for (double t = tInit; t < tShove + tInit; t += deltat) {
     // For all slices.
     for (map<double, vector<Exc> >::iterator slItr = exPairs.begin();
@@ -834,6 +962,197 @@ void Ropewalk::shoveTheDipoles(Event& event) {
 
 //--------------------------------------------------------------------------
 
+// Shove the excitations in all rapidity slices, as when going through
+// all pairs, but only looking at the pairs that can be closer than the
+// cut-off radius.
+
+void Ropewalk::shoveIndexed(const vector<double>& rapidities,
+  vector< vector<RopeDipole*> >& sliceDipoles) {
+
+  // Give the dipoles pointers to their excitations. Only dipoles with a
+  // dipole from another string in the same slice can be shoved.
+  int nSlice = sliceDipoles.size();
+  for (int i = 0; i < nSlice; ++i) {
+    vector<RopeDipole*>& tmp = sliceDipoles[i];
+    bool hasPairs = false;
+    for (int k = 1, M = tmp.size(); k < M && !hasPairs; ++k)
+      if (tmp[k]->index() != tmp[0]->index()) hasPairs = true;
+    if (!hasPairs) continue;
+    for (int j = 0, M = tmp.size(); j < M; ++j)
+      tmp[j]->addExcitation(rapidities[i], &eParticles[i][j]);
+  }
+
+  // Shoving loop.
+  for (double t = tInit; t < tShove + tInit; t += deltat) {
+    // The string radius, as in the shoving of all pairs.
+    double rt = max(t, 1. / showerCut / 5.068);
+    rt = min(rt, r0 * gExponent);
+    // For all slices.
+    for (int i = 0; i < nSlice; ++i)
+      shoveSlice(i, rapidities[i], rt, sliceDipoles[i]);
+
+    // Propagate the dipoles.
+    for (DMap::iterator dItr = dipoles.begin(); dItr != dipoles.end(); ++dItr)
+      dItr->second.propagate(deltat, m0);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Shove the excitations in one rapidity slice for one time step. The
+// pairs are taken in the same order as when going through all pairs, but
+// for each excitation only the ones in the same or adjacent cells of a
+// transverse grid are looked at, with cells wider than the cut-off
+// radius. A push moves the dipole ends, which can move the position of
+// a dipole far, so the dipoles sharing an end with the pushed ones are
+// moved in the grid right away.
+
+void Ropewalk::shoveSlice(int i, double y, double rt,
+  vector<RopeDipole*>& tmp) {
+
+  int M = tmp.size();
+  if (M < 2) return;
+  double rCut = rCutOff * rt;
+
+  // The positions of the dipoles. A dipole fixes its rest frame the first
+  // time its position is asked for, so the ones without a rest frame are
+  // paired with all others, to fix it at the same pair as otherwise.
+  vector<Vec4> b(M);
+  vector<bool> noFrame(M, false);
+  vector<int> noFrameList;
+  bool hasPosition = false;
+  double xLow = 0., yLow = 0., xHigh = 0., yHigh = 0.;
+  for (int j = 0; j < M; ++j) {
+    if (!tmp[j]->hasRestFrame()) {
+      noFrame[j] = true;
+      noFrameList.push_back(j);
+      continue;
+    }
+    b[j] = tmp[j]->bInterpolateDip(y, m0);
+    if (!isfinite(b[j].px()) || !isfinite(b[j].py())) continue;
+    if (!hasPosition) {
+      xLow = xHigh = b[j].px();
+      yLow = yHigh = b[j].py();
+      hasPosition = true;
+    }
+    xLow  = min(xLow, b[j].px());
+    xHigh = max(xHigh, b[j].px());
+    yLow  = min(yLow, b[j].py());
+    yHigh = max(yHigh, b[j].py());
+  }
+
+  // The grid has about as many cells as there are dipoles, and positions
+  // outside of it are put in the edge cells. If all cells are adjacent
+  // anyway, all pairs are looked at.
+  double cellSize = max( SHOVECELLWIDTH * rCut,
+    max(xHigh - xLow, yHigh - yLow) / max(1., floor(sqrt(double(M)))) );
+  bool useGrid = rCut > 0. && hasPosition && isfinite(cellSize);
+  int nxCell = useGrid ? int((xHigh - xLow) / cellSize) + 1 : 1;
+  int nyCell = useGrid ? int((yHigh - yLow) / cellSize) + 1 : 1;
+  if (nxCell <= 3 && nyCell <= 3) useGrid = false;
+  auto cellIndex = [&](const Vec4& bNow) {
+    double fx = (bNow.px() - xLow) / cellSize;
+    double fy = (bNow.py() - yLow) / cellSize;
+    if (!isfinite(fx) || !isfinite(fy)) return -1;
+    int ix = (fx < 0.) ? 0 : (fx < nxCell - 1.) ? int(fx) : nxCell - 1;
+    int iy = (fy < 0.) ? 0 : (fy < nyCell - 1.) ? int(fy) : nyCell - 1;
+    return ix * nyCell + iy;
+  };
+  vector< vector<int> > cells(useGrid ? nxCell * nyCell : 0);
+  vector<int> cellOf(M, -1);
+  vector< pair<int, int> > ends;
+  if (useGrid) {
+    for (int j = 0; j < M; ++j) {
+      if (noFrame[j]) continue;
+      cellOf[j] = cellIndex(b[j]);
+      if (cellOf[j] >= 0) cells[cellOf[j]].push_back(j);
+    }
+    // The ends of the dipoles, to find the ones moved by a push.
+    for (int j = 0; j < M; ++j) {
+      ends.push_back( make_pair(tmp[j]->d1Ptr()->getNe(), j) );
+      ends.push_back( make_pair(tmp[j]->d2Ptr()->getNe(), j) );
+    }
+    sort(ends.begin(), ends.end());
+  }
+
+  // Go through the excitations in order.
+  vector<int> near;
+  for (int j = 0; j < M; ++j) {
+    int kLast = -1;
+    int iNear = 0;
+    bool findNear = true;
+    while (true) {
+      // Find the excitations after the last one that can be close.
+      if (findNear) {
+        near.clear();
+        if (!useGrid || noFrame[j]) {
+          for (int k = kLast + 1; k < M; ++k) near.push_back(k);
+        } else {
+          if (cellOf[j] >= 0) {
+            int ix = cellOf[j] / nyCell;
+            int iy = cellOf[j] % nyCell;
+            for (int jx = max(0, ix - 1); jx <= min(nxCell - 1, ix + 1); ++jx)
+            for (int jy = max(0, iy - 1); jy <= min(nyCell - 1, iy + 1); ++jy)
+              for (int n = 0, N = cells[jx * nyCell + jy].size(); n < N; ++n)
+                if (cells[jx * nyCell + jy][n] > kLast)
+                  near.push_back(cells[jx * nyCell + jy][n]);
+          }
+          for (int n = 0, N = noFrameList.size(); n < N; ++n)
+            if (noFrameList[n] > kLast) near.push_back(noFrameList[n]);
+          sort(near.begin(), near.end());
+        }
+        iNear = 0;
+        findNear = false;
+      }
+      if (iNear == int(near.size())) break;
+      int k = near[iNear++];
+      kLast = k;
+      // Don't allow a string to shove itself.
+      if (j == k || tmp[j]->index() == tmp[k]->index()) continue;
+      Exc ep(y, m0, i, j, k, tmp[j], tmp[k]);
+      ep.pp1 = &eParticles[i][j];
+      ep.pp2 = &eParticles[i][k];
+      // The direction, from the positions kept in the grid if there.
+      Vec4 direction = (useGrid && !noFrame[j] && !noFrame[k])
+        ? b[j] - b[k] : ep.direction();
+      double dist = direction.pT();
+      // Calculate the push, its direction and do the shoving.
+      if (!(dist < rCut)) continue;
+      double gain = 0.5 * deltay * deltat * gAmplitude * dist / rt / rt
+                  * exp( -0.25 * dist * dist / rt / rt);
+      double dpx = dist > 0.0 ? gain * direction.px() / dist: 0.0;
+      double dpy = dist > 0.0 ? gain * direction.py() / dist: 0.0;
+      ep.shove(dpx, dpy);
+      if (!useGrid) continue;
+
+      // Update the dipoles with an end in one of the pushed dipoles.
+      int neMoved[4] = { tmp[j]->d1Ptr()->getNe(), tmp[j]->d2Ptr()->getNe(),
+        tmp[k]->d1Ptr()->getNe(), tmp[k]->d2Ptr()->getNe() };
+      for (int m = 0; m < 4; ++m)
+      for (vector< pair<int, int> >::iterator eItr = lower_bound(ends.begin(),
+        ends.end(), make_pair(neMoved[m], -1));
+        eItr != ends.end() && eItr->first == neMoved[m]; ++eItr) {
+        int l = eItr->second;
+        if (noFrame[l]) continue;
+        b[l] = tmp[l]->bInterpolateDip(y, m0);
+        int cellNow = cellIndex(b[l]);
+        if (cellNow == cellOf[l]) continue;
+        if (cellOf[l] >= 0) {
+          vector<int>& cell = cells[cellOf[l]];
+          cell.erase( find(cell.begin(), cell.end(), l) );
+        }
+        if (cellNow >= 0) cells[cellNow].push_back(l);
+        cellOf[l] = cellNow;
+        findNear = true;
+      }
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Extract all dipoles from an event.
 
 bool Ropewalk::extractDipoles(Event& event, ColConfig& colConfig) {
@@ -899,6 +1218,10 @@ const double RopeFragPars::ACONV = 0.001;
 // Low z cut-off in fragmentation function.
 const double RopeFragPars::ZCUT = 1.0e-4;
 
+// Largest and smallest grid spacing of the parameter table.
+const double RopeFragPars::DHMAX = 1.0;
+const double RopeFragPars::DHMIN = 1.0 / 64.;
+
 //--------------------------------------------------------------------------
 
 // The init function sets up initial parameters from settings.
@@ -918,13 +1241,15 @@ bool RopeFragPars::init() {
     &yIn, &xiIn, &kappaIn};
   for (int i = 0; i < len; ++i) *variables[i] = parm(params[i]);
 
-  // Insert the h = 1 case immediately.
+  // The h = 1 case.
   sigmaEff = sigmaIn, aEff = aIn, adiqEff = adiqIn, bEff = bIn,
     rhoEff = rhoIn, xEff = xIn, yEff = yIn, xiEff = xiIn, kappaEff = kappaIn;
-  if (!insertEffectiveParameters(1.0)) {
-    loggerPtr->ERROR_MSG("failed to insert defaults");
-    return false;
-  }
+
+  // Tabulate the parameters, unless exact calculation is requested.
+  tolerance = parm("Ropewalk:fragParsTolerance");
+  hMax      = parm("Ropewalk:fragParsHMax");
+  hasLast   = false;
+  initTable();
 
   return true;
 
@@ -937,50 +1262,116 @@ bool RopeFragPars::init() {
 
 map<string,double> RopeFragPars::getEffectiveParameters(double h) {
 
-  map<double, map<string, double> >::iterator parItr = parameters.find(h);
+  FragParContainer fragPars = getEffectiveFragPars(h);
+  map<string,double> p;
+  p["StringPT:sigma"]          = fragPars.sigma;
+  p["StringZ:bLund"]           = fragPars.bLund;
+  p["StringFlav:probStoUD"]    = fragPars.probStoUD;
+  p["StringFlav:probSQtoQQ"]   = fragPars.probSQtoQQ;
+  p["StringFlav:probQQ1toQQ0"] = fragPars.probQQ1toQQ0;
+  p["StringFlav:probQQtoQ"]    = fragPars.probQQtoQ;
+  p["StringZ:aLund"]           = fragPars.aLund;
+  p["StringZ:aExtraDiquark"]   = fragPars.aExtraDiquark;
+  p["StringFlav:kappa"]        = kappaIn * h;
+  return p;
 
-  // If the parameters are already calculated, return them.
-  if ( parItr != parameters.end()) return parItr->second;
+}
 
-  // Otherwise calculate them.
-  if (!calculateEffectiveParameters(h))
-    loggerPtr->ERROR_MSG("calculating effective parameters");
+//--------------------------------------------------------------------------
 
-  // And insert them.
-  if (!insertEffectiveParameters(h))
-    loggerPtr->ERROR_MSG("inserting effective parameters");
+// Return parameters at given string tension, in a container that can be
+// passed directly to the fragmentation selectors.
 
-  // And recurse.
-  return getEffectiveParameters(h);
+FragParContainer RopeFragPars::getEffectiveFragPars(double h) {
+
+  // Calculate the parameters outside of the table range. Reuse the last
+  // result if h is unchanged, as it is for a fixed string tension.
+  if (table.empty() || h < 1. || h > hMax) {
+    if (!hasLast || h != hLast) {
+      fragParsLast = calculateFragPars(h);
+      hLast        = h;
+      hasLast      = true;
+    }
+    return fragParsLast;
+  }
+
+  // Else interpolate linearly between the two nearest grid points.
+  // At a grid point the tabulated values are returned unchanged.
+  double x = (h - 1.) / dh;
+  int    i = int(x);
+  if (i >= int(table.size()) - 1) return table.back();
+  double f = x - i;
+  const FragParContainer& lo = table[i];
+  const FragParContainer& hi = table[i + 1];
+  return FragParContainer(
+    lo.sigma         + f * (hi.sigma         - lo.sigma),
+    lo.aLund         + f * (hi.aLund         - lo.aLund),
+    lo.bLund         + f * (hi.bLund         - lo.bLund),
+    lo.aExtraDiquark + f * (hi.aExtraDiquark - lo.aExtraDiquark),
+    lo.probStoUD     + f * (hi.probStoUD     - lo.probStoUD),
+    lo.probSQtoQQ    + f * (hi.probSQtoQQ    - lo.probSQtoQQ),
+    lo.probQQ1toQQ0  + f * (hi.probQQ1toQQ0  - lo.probQQ1toQQ0),
+    lo.probQQtoQ     + f * (hi.probQQtoQ     - lo.probQQtoQ) );
 
 }
 
 //--------------------------------------------------------------------------
 
-// Get the Fragmentation function a parameter from cache or calculate it.
+// Set up the table with the largest grid spacing, a power of two, for
+// which linear interpolation meets the required tolerance at the
+// midpoints of all grid cells.
+
+void RopeFragPars::initTable() {
+
+  table.clear();
+  dh = 0.;
+  if (tolerance <= 0. || hMax <= 1.) return;
+
+  bool accept = false;
+  for (dh = DHMAX; ; dh /= 2.) {
+
+    // Parameters at the grid points.
+    int nCell = int(ceil((hMax - 1.) / dh - 1e-10));
+    table.resize(nCell + 1);
+    for (int i = 0; i <= nCell; ++i) table[i] = calculateFragPars(1. + i * dh);
+    hMax = 1. + nCell * dh;
+
+    // Check linear interpolation at the midpoints. The a parameters are
+    // only known to the precision of the iterative solution.
+    accept = true;
+    for (int i = 0; i < nCell && accept; ++i) {
+      FragParContainer mid = calculateFragPars(1. + (i + 0.5) * dh);
+      const FragParContainer& lo = table[i];
+      const FragParContainer& hi = table[i + 1];
+      double dev = max( max( abs(0.5 * (lo.sigma + hi.sigma) - mid.sigma),
+        abs(0.5 * (lo.bLund + hi.bLund) - mid.bLund) ),
+        max( abs(0.5 * (lo.probStoUD + hi.probStoUD) - mid.probStoUD),
+        abs(0.5 * (lo.probSQtoQQ + hi.probSQtoQQ) - mid.probSQtoQQ) ) );
+      dev = max( dev, max(
+        abs(0.5 * (lo.probQQ1toQQ0 + hi.probQQ1toQQ0) - mid.probQQ1toQQ0),
+        abs(0.5 * (lo.probQQtoQ + hi.probQQtoQ) - mid.probQQtoQ) ) );
+      if (dev > tolerance) accept = false;
+    }
+    if (accept || dh <= DHMIN) break;
+  }
+
+  if (!accept) loggerPtr->WARNING_MSG(
+    "required tolerance not met with smallest grid spacing");
+
+}
+
+//--------------------------------------------------------------------------
+
+// Calculate the Fragmentation function a parameter.
 
 double RopeFragPars::getEffectiveA(double thisb, double mT2, bool isDiquark) {
 
   // Check for  the trivial case.
   if (thisb == bIn) return (isDiquark ? aIn + adiqIn : aIn);
 
-  // We order by b*mT2
-  map<double, double>* aMPtr = (isDiquark ? &aDiqMap : &aMap);
-  double bmT2 = mT2 * thisb;
-
-  // Check if we have already calculated this a value before.
-  map<double,double>::iterator aItr = aMPtr->find(bmT2);
-  if (aItr != aMPtr->end()) return aItr->second;
-
   // Otherwise calculate it.
-  double ae = ( isDiquark ? aEffective(aIn + adiqIn, thisb, mT2)
+  return ( isDiquark ? aEffective(aIn + adiqIn, thisb, mT2)
     : aEffective(aIn, thisb, mT2) );
-  if (isDiquark) {
-    double suba = getEffectiveA(thisb, mT2, false);
-    aMPtr->insert( make_pair(bmT2, ae - suba) );
-  }
-  else aMPtr->insert(make_pair(bmT2, ae));
-  return ae;
 
 }
 
@@ -1032,22 +1423,17 @@ bool RopeFragPars::calculateEffectiveParameters(double h) {
 
 //--------------------------------------------------------------------------
 
-// Insert calculated parameters in cache for later (re-)use.
+// Calculate the effective parameters and return them in a container.
 
-bool RopeFragPars::insertEffectiveParameters(double h) {
+FragParContainer RopeFragPars::calculateFragPars(double h) {
 
-  map<string,double> p;
-  p["StringPT:sigma"]          = sigmaEff;
-  p["StringZ:bLund"]           = bEff;
-  p["StringFlav:probStoUD"]    = rhoEff;
-  p["StringFlav:probSQtoQQ"]   = xEff;
-  p["StringFlav:probQQ1toQQ0"] = yEff;
-  p["StringFlav:probQQtoQ"]    = xiEff;
-  p["StringZ:aLund"]           = aEff;
-  p["StringZ:aExtraDiquark"]   = adiqEff;
-  p["StringFlav:kappa"]        = kappaEff;
-
-  return (parameters.insert( make_pair(h,p)).second );
+  // The input values are used unchanged for h = 1.
+  if (h == 1.) return FragParContainer( sigmaIn, aIn, bIn, adiqIn, rhoIn,
+    xIn, yIn, xiIn);
+  if (!calculateEffectiveParameters(h))
+    loggerPtr->ERROR_MSG("calculating effective parameters");
+  return FragParContainer( sigmaEff, aEff, bEff, adiqEff, rhoEff, xEff,
+    yEff, xiEff);
 
 }
 
@@ -1148,39 +1534,104 @@ double RopeFragPars::trapIntegrate( double a, double b, double mT2,
 
 //--------------------------------------------------------------------------
 
+// Constants: could be changed here if desired, but normally should not.
+
+// Names of the parameters passed to the fragmentation selectors, in the
+// order of FragParContainer.
+const string FlavourRope::FRAGPARNAMES[FlavourRope::NFRAGPARS] = {
+  "StringPT:sigma", "StringZ:aLund", "StringZ:bLund", "StringZ:aExtraDiquark",
+  "StringFlav:probStoUD", "StringFlav:probSQtoQQ", "StringFlav:probQQ1toQQ0",
+  "StringFlav:probQQtoQ"};
+
+//--------------------------------------------------------------------------
+
 // Change the fragmentation parameters.
 
 bool FlavourRope::doChangeFragPar(StringFlav* flavPtr, StringZ* zPtr,
  StringPT * pTPtr, double m2Had, vector<int> iParton, int endId) {
 
-  // The new parameters.
-  map<string, double> newPar;
-  if (doBuffon)
-    newPar = fetchParametersBuffon(m2Had, iParton, endId);
-  else
-    newPar = fetchParameters(m2Had, iParton, endId);
-  // Change settings to new settings.
-  for (map<string, double>::iterator itr = newPar.begin(); itr!=newPar.end();
-    ++itr) settingsPtr->parm( itr->first, itr->second);
-  // Re-initialize flavour, z, and pT selection with new settings.
-  flavPtr->init();
-  zPtr->init();
-  pTPtr->init();
+  // The effective string tension at the breakup.
+  double enh = (doBuffon) ? fetchEnhancementBuffon(m2Had, iParton, endId)
+    : fetchEnhancement(m2Had, iParton, endId);
+
+  // Change settings to new settings, and re-initialize flavour, z,
+  // and pT selection with new settings.
+  if (!directFragPars) {
+    FragParContainer newPar = fp.getEffectiveFragPars(enh);
+    double values[NFRAGPARS] = { newPar.sigma, newPar.aLund, newPar.bLund,
+      newPar.aExtraDiquark, newPar.probStoUD, newPar.probSQtoQQ,
+      newPar.probQQ1toQQ0, newPar.probQQtoQ};
+    for (int i = 0; i < NFRAGPARS; ++i)
+      settingsPtr->parm( fragParHandles[i], values[i]);
+    settingsPtr->parm( kappaHandle, kappaInit * enh);
+    flavPtr->init();
+    zPtr->init();
+    pTPtr->init();
+    return true;
+  }
+
+  // Else update the parameters of the selectors directly. As for Settings,
+  // values outside the allowed range are rejected.
+  FragParContainer newPar = fp.getEffectiveFragPars(enh);
+  setInRange( 0, newPar.sigma,         fragParsNow.sigma);
+  setInRange( 1, newPar.aLund,         fragParsNow.aLund);
+  setInRange( 2, newPar.bLund,         fragParsNow.bLund);
+  setInRange( 3, newPar.aExtraDiquark, fragParsNow.aExtraDiquark);
+  setInRange( 4, newPar.probStoUD,     fragParsNow.probStoUD);
+  setInRange( 5, newPar.probSQtoQQ,    fragParsNow.probSQtoQQ);
+  setInRange( 6, newPar.probQQ1toQQ0,  fragParsNow.probQQ1toQQ0);
+  setInRange( 7, newPar.probQQtoQ,     fragParsNow.probQQtoQ);
+  flavPtr->setFragPars(fragParsNow);
+  zPtr->setFragPars(fragParsNow);
+  pTPtr->setFragPars(fragParsNow);
   return true;
 
 }
 
 //--------------------------------------------------------------------------
 
-// Find breakup placement and fetch effective parameters using Buffon.
+// Store the current parameter values and handles to their settings.
+
+void FlavourRope::initFragParsNow() {
+
+  double* values[NFRAGPARS] = { &fragParsNow.sigma, &fragParsNow.aLund,
+    &fragParsNow.bLund, &fragParsNow.aExtraDiquark, &fragParsNow.probStoUD,
+    &fragParsNow.probSQtoQQ, &fragParsNow.probQQ1toQQ0,
+    &fragParsNow.probQQtoQ};
+  for (int i = 0; i < NFRAGPARS; ++i) {
+    fragParHandles[i] = settingsPtr->parmHandle(FRAGPARNAMES[i]);
+    *values[i] = settingsPtr->parm(fragParHandles[i]);
+  }
+  kappaHandle = settingsPtr->parmHandle("StringFlav:kappa");
+  kappaInit   = settingsPtr->parm(kappaHandle);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Accept a new parameter value only if inside its allowed range.
+
+void FlavourRope::setInRange(int iPar, double valNew, double& valNow) {
+
+  const Parm* range = fragParHandles[iPar].entry();
+  if ( range != nullptr && ( (range->hasMin && valNew < range->valMin)
+    || (range->hasMax && valNew > range->valMax) ) )
+    loggerPtr->ERROR_MSG("value is out of range", FRAGPARNAMES[iPar], true);
+  else valNow = valNew;
 
-map<string, double> FlavourRope::fetchParametersBuffon(double m2Had,
+}
+
+//--------------------------------------------------------------------------
+
+// Find breakup placement and fetch effective string tension using Buffon.
+
+double FlavourRope::fetchEnhancementBuffon(double m2Had,
   vector<int> iParton, int endId) {
   // If effective string tension is set manually, use that.
-  if (fixedKappa) return fp.getEffectiveParameters(h);
+  if (fixedKappa) return h;
   if (!ePtr) {
     loggerPtr->ERROR_MSG("Event pointer not set in FlavourRope");
-    return fp.getEffectiveParameters(1.0);
+    return 1.0;
   }
     if(find(hadronized.begin(),hadronized.end(),*iParton.begin()) ==
       hadronized.end()){
@@ -1193,7 +1644,7 @@ map<string, double> FlavourRope::fetchParametersBuffon(double m2Had,
     if(ePtr->at(*(iParton.begin())).id() != endId &&
         ePtr->at(*(iParton.end() - 1)).id() != endId) {
       loggerPtr->ERROR_MSG("Quark end inconsistency");
-      return fp.getEffectiveParameters(1.0);
+      return 1.0;
     }
 
       // First we must let the string vector point in the right direction
@@ -1223,7 +1674,7 @@ map<string, double> FlavourRope::fetchParametersBuffon(double m2Had,
             if(ePtr->at(*(dipItr - 1)).id() != 21) {
               loggerPtr->ERROR_MSG(
                 "Connecting partons should always be gluons");
-              return fp.getEffectiveParameters(1.0);
+              return 1.0;
             }
 
             hadronic4Momentum -= 0.5*ePtr->at(*(dipItr -1)).p();
@@ -1240,12 +1691,12 @@ map<string, double> FlavourRope::fetchParametersBuffon(double m2Had,
       // If we reached the end
       // we are in a small string that should just be collapsed
       if(dipItr == iParton.end())
-        return fp.getEffectiveParameters(1.0);
+        return 1.0;
       // Sanity check
       if(dipFrac < 0 || dipFrac > 1) {
         loggerPtr->ERROR_MSG(
           "Dipole exceed with fraction less than 0 or greater than 1");
-        return fp.getEffectiveParameters(1.0);
+        return 1.0;
       }
       // We now figure out at what rapidity value,
       // in the lab system, the string is breaking
@@ -1258,7 +1709,7 @@ map<string, double> FlavourRope::fetchParametersBuffon(double m2Had,
         if(dipItr == iParton.begin()) {
           loggerPtr->ERROR_MSG(
             "We are somehow before the first dipole on a string");
-          return fp.getEffectiveParameters(1.0);
+          return 1.0;
         }
         double dy = ePtr->at(*dipItr).y() - ePtr->at(*(dipItr - 1)).y();
         yBreak = ePtr->at(*(dipItr - 1)).y() + dipFrac*dy;
@@ -1296,26 +1747,26 @@ map<string, double> FlavourRope::fetchParametersBuffon(double m2Had,
       }
       enh = 0.25*(2.0*p+q+2.0);
 
-      return fp.getEffectiveParameters(enh);
+      return enh;
     }
    // For closed gluon loops we cannot distinguish the ends.
    // Do nothing instead
    else{
-      return fp.getEffectiveParameters(1.0);
+      return 1.0;
    }
-      return fp.getEffectiveParameters(1.0);
+      return 1.0;
 }
 
 //--------------------------------------------------------------------------
-// Find breakup placement and fetch effective parameters using Ropewalk.
+// Find breakup placement and fetch effective string tension using Ropewalk.
 
-map<string, double> FlavourRope::fetchParameters(double m2Had,
-  vector<int> iParton, int endId) {
+double FlavourRope::fetchEnhancement(double m2Had,
+  const vector<int>& iParton, int endId) {
   // If effective string tension is set manually, use that.
-  if (fixedKappa) return fp.getEffectiveParameters(h);
+  if (fixedKappa) return h;
   if (!ePtr) {
     loggerPtr->ERROR_MSG("Event pointer not set in FlavourRope");
-    return fp.getEffectiveParameters(1.0);
+    return 1.0;
   }
   Vec4 mom;
   int eventIndex = -1;
@@ -1325,7 +1776,7 @@ map<string, double> FlavourRope::fetchParameters(double m2Had,
   else if( ePtr->at(iParton[iParton.size() - 1]).id() == endId) dirPos = false;
   else {
     loggerPtr->ERROR_MSG("Could not get string direction");
-    return fp.getEffectiveParameters(1.0);
+    return 1.0;
   }
 
   for (int i = 0, N = iParton.size(); i < N; ++i) {
@@ -1355,9 +1806,8 @@ map<string, double> FlavourRope::fetchParameters(double m2Had,
     dipFrac = (sqrt(m2Had) - sqrt(m2Small)) / (sqrt(m2Here) - sqrt(m2Small));
   }
   else dipFrac = sqrt(m2Had / m2Here);
-  double enh = rwPtr->getKappaHere( iParton[eventIndex - 1],
+  return rwPtr->getKappaHere( iParton[eventIndex - 1],
     iParton[eventIndex], dipFrac);
-  return fp.getEffectiveParameters(enh);
 
 }
 
@@ -1367,7 +1817,7 @@ map<string, double> FlavourRope::fetchParameters(double m2Had,
 bool FlavourRope::initEvent(Event& event, ColConfig& colConfig) {
 
   setEventPtr(event);
-  if (flag("PartonVertex:setVertex") && !flag("Ropewalk:doBuffon")) {
+  if (useVertices) {
     rwPtr->extractDipoles(event, colConfig);
     rwPtr->calculateOverlaps();
   }
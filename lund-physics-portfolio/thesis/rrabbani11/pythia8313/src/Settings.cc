@@ -15,6 +15,69 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// Binary input and output of the individual database entries, used by
+// the Settings snapshot methods.
+
+//--------------------------------------------------------------------------
+
+static void writeBinary(ostream& os, const Flag& f) {
+  writeBinary(os, f.name); writeBinary(os, f.valNow);
+  writeBinary(os, f.valDefault);}
+
+static bool readBinary(istream& is, Flag& f) {
+  return readBinary(is, f.name) && readBinary(is, f.valNow)
+    && readBinary(is, f.valDefault);}
+
+static void writeBinary(ostream& os, const Mode& m) {
+  writeBinary(os, m.name); writeBinary(os, m.valNow);
+  writeBinary(os, m.valDefault); writeBinary(os, m.hasMin);
+  writeBinary(os, m.hasMax); writeBinary(os, m.valMin);
+  writeBinary(os, m.valMax); writeBinary(os, m.optOnly);}
+
+static bool readBinary(istream& is, Mode& m) {
+  return readBinary(is, m.name) && readBinary(is, m.valNow)
+    && readBinary(is, m.valDefault) && readBinary(is, m.hasMin)
+    && readBinary(is, m.hasMax) && readBinary(is, m.valMin)
+    && readBinary(is, m.valMax) && readBinary(is, m.optOnly);}
+
+// Parm, MVec and PVec share the same layout.
+template<typename T> static void writeBinaryRange(ostream& os, const T& p) {
+  writeBinary(os, p.name); writeBinary(os, p.valNow);
+  writeBinary(os, p.valDefault); writeBinary(os, p.hasMin);
+  writeBinary(os, p.hasMax); writeBinary(os, p.valMin);
+  writeBinary(os, p.valMax);}
+
+template<typename T> static bool readBinaryRange(istream& is, T& p) {
+  return readBinary(is, p.name) && readBinary(is, p.valNow)
+    && readBinary(is, p.valDefault) && readBinary(is, p.hasMin)
+    && readBinary(is, p.hasMax) && readBinary(is, p.valMin)
+    && readBinary(is, p.valMax);}
+
+static void writeBinary(ostream& os, const Parm& p) {writeBinaryRange(os, p);}
+static void writeBinary(ostream& os, const MVec& p) {writeBinaryRange(os, p);}
+static void writeBinary(ostream& os, const PVec& p) {writeBinaryRange(os, p);}
+static bool readBinary(istream& is, Parm& p) {return readBinaryRange(is, p);}
+static bool readBinary(istream& is, MVec& p) {return readBinaryRange(is, p);}
+static bool readBinary(istream& is, PVec& p) {return readBinaryRange(is, p);}
+
+// Word, FVec and WVec only have name, current and default value.
+template<typename T> static void writeBinaryPlain(ostream& os, const T& w) {
+  writeBinary(os, w.name); writeBinary(os, w.valNow);
+  writeBinary(os, w.valDefault);}
+
+template<typename T> static bool readBinaryPlain(istream& is, T& w) {
+  return readBinary(is, w.name) && readBinary(is, w.valNow)
+    && readBinary(is, w.valDefault);}
+
+static void writeBinary(ostream& os, const Word& w) {writeBinaryPlain(os, w);}
+static void writeBinary(ostream& os, const FVec& w) {writeBinaryPlain(os, w);}
+static void writeBinary(ostream& os, const WVec& w) {writeBinaryPlain(os, w);}
+static bool readBinary(istream& is, Word& w) {return readBinaryPlain(is, w);}
+static bool readBinary(istream& is, FVec& w) {return readBinaryPlain(is, w);}
+static bool readBinary(istream& is, WVec& w) {return readBinaryPlain(is, w);}
+
+//==========================================================================
+
 // Settings class.
 // This class contains flags, modes, parms and words used in generation.
 
@@ -1168,6 +1231,51 @@ bool Settings::writeFileXML(ostream& os) {
 
 //--------------------------------------------------------------------------
 
+// Write the complete database, with current and default values, in a
+// compact binary format, to be read back by readSnapshot. Plugin
+// libraries are not included, and have to be registered again.
+
+bool Settings::writeSnapshot(ostream& os) {
+
+  writeBinary(os, flags);
+  writeBinary(os, modes);
+  writeBinary(os, parms);
+  writeBinary(os, words);
+  writeBinary(os, fvecs);
+  writeBinary(os, mvecs);
+  writeBinary(os, pvecs);
+  writeBinary(os, wvecs);
+  writeBinary(os, readStringHistory);
+  writeBinary(os, readStringSubrun);
+  writeBinary(os, readingFailedSave);
+  return os.good();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Replace the database by one written with writeSnapshot.
+
+bool Settings::readSnapshot(istream& is) {
+
+  isInit = readBinary(is, flags) && readBinary(is, modes)
+    && readBinary(is, parms) && readBinary(is, words)
+    && readBinary(is, fvecs) && readBinary(is, mvecs)
+    && readBinary(is, pvecs) && readBinary(is, wvecs)
+    && readBinary(is, readStringHistory) && readBinary(is, readStringSubrun)
+    && readBinary(is, readingFailedSave);
+  lineSaved = false;
+  if (!isInit) {
+    flags.clear(); modes.clear(); parms.clear(); words.clear();
+    fvecs.clear(); mvecs.clear(); pvecs.clear(); wvecs.clear();
+    loggerPtr->ERROR_MSG("could not read settings snapshot");
+  }
+  return isInit;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Print out table of database in lexigraphical order.
 
 void Settings::list(bool doListAll,  bool doListString, string match) {
@@ -1597,19 +1705,22 @@ void Settings::resetAll() {
 // Give back current value, with check that key exists.
 
 bool Settings::flag(string keyIn) {
-  if (isFlag(keyIn)) return flags[toLower(keyIn)].valNow;
+  auto flagEntry = flags.find(toLower(keyIn));
+  if (flagEntry != flags.end()) return flagEntry->second.valNow;
   loggerPtr->ERROR_MSG("unknown key", keyIn);
   return false;
 }
 
 int Settings::mode(string keyIn) {
-  if (isMode(keyIn)) return modes[toLower(keyIn)].valNow;
+  auto modeEntry = modes.find(toLower(keyIn));
+  if (modeEntry != modes.end()) return modeEntry->second.valNow;
   loggerPtr->ERROR_MSG("unknown key", keyIn);
   return 0;
 }
 
 double Settings::parm(string keyIn) {
-  if (isParm(keyIn)) return parms[toLower(keyIn)].valNow;
+  auto parmEntry = parms.find(toLower(keyIn));
+  if (parmEntry != parms.end()) return parmEntry->second.valNow;
   loggerPtr->ERROR_MSG("unknown key", keyIn);
   return 0.;
 }
@@ -1921,6 +2032,73 @@ void Settings::wvec(string keyIn, vector<string> nowIn, bool force) {
 
 //--------------------------------------------------------------------------
 
+// Resolve a flag, mode or parm into a handle. Note whether a change of
+// it triggers further changes, since these are only done by name.
+
+FlagHandle Settings::flagHandle(string keyIn) {
+  string keyLower = toLower(keyIn);
+  auto flagEntry = flags.find(keyLower);
+  if (flagEntry != flags.end())
+    return FlagHandle( &flagEntry->second, keyLower == "print:quiet");
+  loggerPtr->ERROR_MSG("unknown key", keyIn);
+  return FlagHandle();
+}
+
+ModeHandle Settings::modeHandle(string keyIn) {
+  string keyLower = toLower(keyIn);
+  auto modeEntry = modes.find(keyLower);
+  if (modeEntry != modes.end())
+    return ModeHandle( &modeEntry->second, keyLower == "tune:ee"
+      || keyLower == "tune:pp" || keyLower == "vincia:tune");
+  loggerPtr->ERROR_MSG("unknown key", keyIn);
+  return ModeHandle();
+}
+
+ParmHandle Settings::parmHandle(string keyIn) {
+  auto parmEntry = parms.find(toLower(keyIn));
+  if (parmEntry != parms.end()) return ParmHandle( &parmEntry->second, false);
+  loggerPtr->ERROR_MSG("unknown key", keyIn);
+  return ParmHandle();
+}
+
+//--------------------------------------------------------------------------
+
+// Change current value through a handle. Respect limits unless
+// force==true. Invalid handles are ignored.
+
+void Settings::flag(const FlagHandle& handle, bool nowIn) {
+  if (handle.hasSideEffects) flag( handle.entryPtr->name, nowIn);
+  else if (handle.entryPtr) handle.entryPtr->valNow = nowIn;
+}
+
+bool Settings::mode(const ModeHandle& handle, int nowIn, bool force) {
+  if (handle.entryPtr == nullptr) return true;
+  if (handle.hasSideEffects)
+    return mode( handle.entryPtr->name, nowIn, force);
+  Mode& modeNow = *handle.entryPtr;
+  if (!force && ((modeNow.hasMin && nowIn < modeNow.valMin)
+              || (modeNow.hasMax && nowIn > modeNow.valMax)) ) {
+    loggerPtr->ERROR_MSG("value is out of range", modeNow.name, true);
+    return false;
+  }
+  modeNow.valNow = nowIn;
+  return true;
+}
+
+bool Settings::parm(const ParmHandle& handle, double nowIn, bool force) {
+  if (handle.entryPtr == nullptr) return true;
+  Parm& parmNow = *handle.entryPtr;
+  if (!force && ((parmNow.hasMin && nowIn < parmNow.valMin)
+              || (parmNow.hasMax && nowIn > parmNow.valMax)) ) {
+    loggerPtr->ERROR_MSG("value is out of range", parmNow.name, true);
+    return false;
+  }
+  parmNow.valNow = nowIn;
+  return true;
+}
+
+//--------------------------------------------------------------------------
+
 // Restore current value to default.
 
 void Settings::resetFlag(string keyIn) {